@@ -0,0 +1,214 @@
+// Module interface of adpp, which exports the same entities as <adpp/backward.hpp>. Importing translation
+// units load the prebuilt module instead of parsing the headers again, while templates (e.g. derivatives
+// w.r.t. the user's symbols) are still instantiated on use. Enable with the CMake option ADPP_BUILD_MODULE
+// and link against adpp::module.
+module;
+
+#include <adpp/backward.hpp>
+
+export module adpp;
+
+export namespace adpp {
+
+    // type_traits.hpp
+    using adpp::automatic;
+    using adpp::always_false;
+    using adpp::index_constant;
+    using adpp::decayed_trait;
+    using adpp::type_list;
+    using adpp::type_list_size;
+    using adpp::type_list_size_v;
+    using adpp::is_complete;
+    using adpp::is_complete_v;
+    using adpp::first_type;
+    using adpp::first_type_t;
+    using adpp::type_at;
+    using adpp::type_at_t;
+    using adpp::index_of_type;
+    using adpp::index_of_type_v;
+    using adpp::is_any_of;
+    using adpp::is_any_of_v;
+    using adpp::contains_decayed;
+    using adpp::contains_decayed_v;
+    using adpp::are_unique;
+    using adpp::are_unique_v;
+    using adpp::unique_types;
+    using adpp::unique_types_t;
+    using adpp::merged_types;
+    using adpp::merged_types_t;
+    using adpp::merged_unique_types;
+    using adpp::merged_unique_types_t;
+    using adpp::filtered_types;
+    using adpp::filtered_types_t;
+
+    // concepts.hpp & dtype.hpp
+    using adpp::scalar;
+    using adpp::same_remove_cvref_t_as;
+    using adpp::accepts;
+
+    namespace dtype {
+        using adpp::dtype::any;
+        using adpp::dtype::real;
+        using adpp::dtype::integral;
+        using adpp::dtype::vector;
+        using adpp::dtype::matrix;
+        using adpp::dtype::extent;
+        using adpp::dtype::extent_v;
+        using adpp::dtype::accepts;
+    }  // namespace dtype
+
+    // common.hpp
+    using adpp::order;
+    using adpp::first_order;
+    using adpp::second_order;
+    using adpp::third_order;
+    using adpp::row_major;
+    using adpp::column_major;
+    using adpp::row_major_layout;
+    using adpp::column_major_layout;
+    using adpp::storage;
+    using adpp::is_same_object;
+    using adpp::indexed;
+    using adpp::variadic_accessor;
+
+}  // namespace adpp
+
+export namespace adpp::backward {
+
+    // concepts.hpp
+    using adpp::backward::is_symbol;
+    using adpp::backward::is_symbol_v;
+    using adpp::backward::symbolic;
+    using adpp::backward::is_unbound_symbol;
+    using adpp::backward::is_unbound_symbol_v;
+    using adpp::backward::unbound_symbol;
+    using adpp::backward::is_expression;
+    using adpp::backward::is_expression_v;
+    using adpp::backward::term;
+    using adpp::backward::evaluatable_with;
+    using adpp::backward::expression_for;
+    using adpp::backward::into_term;
+    using adpp::backward::value_extent;
+    using adpp::backward::value_extent_v;
+    using adpp::backward::operands;
+    using adpp::backward::operands_t;
+    using adpp::backward::binder;
+
+    // symbols.hpp
+    using adpp::backward::constant;
+    using adpp::backward::cval;
+    using adpp::backward::negatable;
+    using adpp::backward::val;
+    using adpp::backward::value_binder;
+    using adpp::backward::symbol;
+    using adpp::backward::var;
+    using adpp::backward::let;
+
+    namespace literals {
+        using adpp::backward::literals::operator""_c;
+    }  // namespace literals
+
+    // bindings.hpp & derivatives.hpp
+    using adpp::backward::bindings;
+    using adpp::backward::is_binding;
+    using adpp::backward::is_binding_v;
+    using adpp::backward::concatenated;
+    using adpp::backward::bound_expression;
+    using adpp::backward::bindable;
+    using adpp::backward::bind;
+    using adpp::backward::at;
+    using adpp::backward::with;
+    using adpp::backward::where;
+    using adpp::backward::derivatives;
+
+    // expression.hpp
+    using adpp::backward::symbols;
+    using adpp::backward::symbols_t;
+    using adpp::backward::symbols_of;
+    using adpp::backward::unbound_symbols;
+    using adpp::backward::unbound_symbols_t;
+    using adpp::backward::unbound_symbols_of;
+    using adpp::backward::vars;
+    using adpp::backward::vars_t;
+    using adpp::backward::variables_of;
+    using adpp::backward::back_propagator;
+    using adpp::backward::formatter;
+    using adpp::backward::differentiator;
+    using adpp::backward::outline;
+    using adpp::backward::expression;
+    using adpp::backward::tree_size;
+    using adpp::backward::tree_size_v;
+
+    // operators.hpp & linalg.hpp
+    namespace op {
+        using adpp::backward::op::exp;
+        using adpp::backward::op::add;
+        using adpp::backward::op::subtract;
+        using adpp::backward::op::multiply;
+        using adpp::backward::op::divide;
+        using adpp::backward::op::dot;
+        using adpp::backward::op::matvec;
+        using adpp::backward::op::norm2;
+        using adpp::backward::op::quad;
+    }  // namespace op
+
+    using adpp::backward::op_result_t;
+    using adpp::backward::arithmetic_op_result_t;
+    using adpp::backward::operator+;
+    using adpp::backward::operator-;
+    using adpp::backward::operator*;
+    using adpp::backward::operator/;
+    using adpp::backward::exp;
+    using adpp::backward::dot;
+    using adpp::backward::matvec;
+    using adpp::backward::norm2;
+    using adpp::backward::quad;
+
+    // evaluate.hpp & differentiate.hpp
+    using adpp::backward::function;
+    using adpp::backward::evaluate;
+    using adpp::backward::wrt;
+    using adpp::backward::derivatives_of;
+    using adpp::backward::derivative_of;
+    using adpp::backward::grad;
+    using adpp::backward::grad_into;
+    using adpp::backward::jacobian_row_into;
+    using adpp::backward::differentiate;
+    using adpp::backward::gradient_expression;
+
+    // compile.hpp, substitute.hpp, specialize.hpp, incremental.hpp & memoize.hpp
+    using adpp::backward::compiled_function;
+    using adpp::backward::compile;
+    using adpp::backward::substitute;
+    using adpp::backward::precomputed;
+    using adpp::backward::specialize;
+    using adpp::backward::incremental_evaluator;
+    using adpp::backward::memoized;
+
+    // any_expression.hpp, tape.hpp, bytecode.hpp, parse.hpp & codegen.hpp
+    using adpp::backward::any_expression;
+    using adpp::backward::opcode;
+    using adpp::backward::instruction;
+    using adpp::backward::deduplication;
+    using adpp::backward::tape_statistics;
+    using adpp::backward::tape;
+    using adpp::backward::bytecode_instructions_v;
+    using adpp::backward::bytecode;
+    using adpp::backward::to_bytecode;
+    using adpp::backward::expression_parser;
+    using adpp::backward::write_kernel_source;
+    using adpp::backward::write_kernel_header;
+
+    // checkpointing.hpp
+    using adpp::backward::checkpointing_statistics;
+    using adpp::backward::time_stepper;
+
+}  // namespace adpp::backward
+
+
+// The runtime classes for double are compiled once into the module's object file. Targets linking against
+// adpp::module define ADPP_EXTERN_TEMPLATES, such that translation units including the headers declare them
+// as extern templates and use these instantiations, too.
+template class adpp::backward::tape<double>;
+template class adpp::backward::bytecode<double>;
+template class adpp::backward::expression_parser<double>;
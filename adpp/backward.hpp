@@ -2,5 +2,17 @@
 
 #include <adpp/backward/symbols.hpp>
 #include <adpp/backward/operators.hpp>
+#include <adpp/backward/linalg.hpp>
 #include <adpp/backward/evaluate.hpp>
 #include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/compile.hpp>
+#include <adpp/backward/substitute.hpp>
+#include <adpp/backward/specialize.hpp>
+#include <adpp/backward/incremental.hpp>
+#include <adpp/backward/memoize.hpp>
+#include <adpp/backward/any_expression.hpp>
+#include <adpp/backward/tape.hpp>
+#include <adpp/backward/bytecode.hpp>
+#include <adpp/backward/parse.hpp>
+#include <adpp/backward/codegen.hpp>
+#include <adpp/backward/checkpointing.hpp>
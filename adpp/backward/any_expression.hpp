@@ -0,0 +1,270 @@
+#pragma once
+
+#include <new>
+#include <span>
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/derivatives.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/substitute.hpp>
+
+namespace adpp::backward {
+
+// Type-erased expression of the given (scalar-valued) symbols, which can be stored in containers, e.g. to hold
+// different residuals per material model. It wraps functions, (bound) expressions and anything that can be
+// evaluated and back-propagated with bindings for the symbols. Small objects are stored in place, and all
+// operations dispatch through a static table of function pointers. The batch interface evaluates many points
+// (given row-wise, one value per symbol) with a single indirect call, so the dispatch is amortized over them.
+template<scalar R, typename... S>
+    requires(sizeof...(S) > 0 and are_unique_v<S...> and std::conjunction_v<is_unbound_symbol<S>...>)
+class any_expression {
+    static_assert(((value_extent_v<S> == 1) and ...), "Type-erased expressions only support scalar-valued symbols");
+
+    using point_t = std::array<R, sizeof...(S)>;
+    using names_t = std::array<std::string_view, sizeof...(S)>;
+    using values_t = bindings<value_binder<S, R>...>;
+
+ public:
+    using value_type = R;
+    using derivatives_type = derivatives<R, S...>;
+
+    static constexpr std::size_t arity = sizeof...(S);
+    static constexpr std::size_t buffer_size = 48;
+
+    constexpr any_expression() noexcept = default;
+
+    template<typename E>
+        requires(!std::is_same_v<std::remove_cvref_t<E>, any_expression>)
+    any_expression(E&& e) {
+        using T = std::remove_cvref_t<E>;
+        if constexpr (_is_local<T>)
+            ::new (static_cast<void*>(_buffer)) T(std::forward<E>(e));
+        else
+            ::new (static_cast<void*>(_buffer)) T*(new T(std::forward<E>(e)));
+        _vtable = &_vtable_for<T>;
+    }
+
+    any_expression(const any_expression& other) {
+        if (other._vtable) {
+            other._vtable->copy(other._buffer, _buffer);
+            _vtable = other._vtable;
+        }
+    }
+
+    any_expression(any_expression&& other) noexcept {
+        if (other._vtable) {
+            other._vtable->move(other._buffer, _buffer);
+            _vtable = std::exchange(other._vtable, nullptr);
+        }
+    }
+
+    any_expression& operator=(const any_expression& other) {
+        if (this != &other)
+            *this = any_expression{other};
+        return *this;
+    }
+
+    any_expression& operator=(any_expression&& other) noexcept {
+        if (this != &other) {
+            _reset();
+            if (other._vtable) {
+                other._vtable->move(other._buffer, _buffer);
+                _vtable = std::exchange(other._vtable, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    ~any_expression() {
+        _reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return _vtable != nullptr;
+    }
+
+    template<typename... B>
+    R operator()(const bindings<B...>& values) const {
+        return evaluate(values);
+    }
+
+    template<typename... B>
+    R evaluate(const bindings<B...>& values) const {
+        const point_t point{static_cast<R>(values[S{}])...};
+        R result;
+        _table().evaluate(_buffer, point.data(), &result, 1);
+        return result;
+    }
+
+    template<typename... B>
+    derivatives_type grad(const bindings<B...>& values) const {
+        return value_and_grad(values).second;
+    }
+
+    template<typename... B>
+    std::pair<R, derivatives_type> value_and_grad(const bindings<B...>& values) const {
+        const point_t point{static_cast<R>(values[S{}])...};
+        std::pair<R, derivatives_type> result;
+        _table().value_and_grad(_buffer, point.data(), &result.first, result.second.as_array().data(), 1);
+        return result;
+    }
+
+    // evaluates the points given row-wise in `points`, writing one value per point into `values`
+    void evaluate(std::span<const R> points, std::span<R> values) const {
+        const std::size_t n = _num_points(points, values);
+        _table().evaluate(_buffer, points.data(), values.data(), n);
+    }
+
+    // as above, additionally writing the gradient for each point row-wise into `gradients`
+    void value_and_grad(std::span<const R> points, std::span<R> values, std::span<R> gradients) const {
+        const std::size_t n = _num_points(points, values);
+        if (gradients.size() < n*arity)
+            throw std::invalid_argument("Gradient buffer is too small");
+        _table().value_and_grad(_buffer, points.data(), values.data(), gradients.data(), n);
+    }
+
+    // writes the expression using the given names for the symbols
+    template<typename... B>
+    void export_to(std::ostream& out, const bindings<B...>& name_bindings) const {
+        const names_t names{std::string_view{name_bindings[S{}]}...};
+        _table().export_to(_buffer, out, names);
+    }
+
+ private:
+    struct vtable {
+        void (*evaluate)(const std::byte*, const R* points, R* values, std::size_t n);
+        void (*value_and_grad)(const std::byte*, const R* points, R* values, R* gradients, std::size_t n);
+        void (*export_to)(const std::byte*, std::ostream&, const names_t&);
+        void (*copy)(const std::byte*, std::byte*);
+        void (*move)(std::byte*, std::byte*) noexcept;
+        void (*destroy)(std::byte*) noexcept;
+    };
+
+    template<typename T>
+    static constexpr bool _is_local = sizeof(T) <= buffer_size
+        and alignof(T) <= alignof(std::max_align_t)
+        and std::is_nothrow_move_constructible_v<T>;
+
+    template<typename T>
+    static const T& _get(const std::byte* buffer) noexcept {
+        if constexpr (_is_local<T>)
+            return *std::launder(reinterpret_cast<const T*>(buffer));
+        else
+            return **std::launder(reinterpret_cast<T* const*>(buffer));
+    }
+
+    template<std::size_t... i>
+    static values_t _bind(const R* point, const std::index_sequence<i...>&) noexcept {
+        return values_t{value_binder<S, R>{S{}, point[i]}...};
+    }
+
+    template<typename T>
+    static void _evaluate(const std::byte* buffer, const R* points, R* values, std::size_t n) {
+        const T& e = _get<T>(buffer);
+        for (std::size_t p = 0; p < n; ++p)
+            values[p] = static_cast<R>(e.evaluate(_bind(points + p*arity, std::index_sequence_for<S...>{})));
+    }
+
+    template<typename T>
+    static void _value_and_grad(const std::byte* buffer, const R* points, R* values, R* gradients, std::size_t n) {
+        const T& e = _get<T>(buffer);
+        for (std::size_t p = 0; p < n; ++p) {
+            auto [value, derivs] = e.template back_propagate<R>(
+                _bind(points + p*arity, std::index_sequence_for<S...>{}), type_list<S...>{}
+            );
+            values[p] = static_cast<R>(value);
+            std::ranges::copy(derivs.as_array(), gradients + p*arity);
+        }
+    }
+
+    template<typename T>
+    static void _export_to(const std::byte* buffer, std::ostream& out, const names_t& names) {
+        const auto name_bindings = [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return bindings<value_binder<S, std::string_view>...>{value_binder<S, std::string_view>{S{}, names[i]}...};
+        } (std::index_sequence_for<S...>{});
+
+        const T& e = _get<T>(buffer);
+        if constexpr (detail::is_bound_expression<T>::value)
+            detail::bound_expression_access::expression_of(e).export_to(
+                out, concatenated(detail::bound_expression_access::bindings_of(e), name_bindings)
+            );
+        else
+            typename detail::unbound<T>::type{}.export_to(out, name_bindings);
+    }
+
+    template<typename T>
+    static void _copy(const std::byte* from, std::byte* to) {
+        if constexpr (_is_local<T>)
+            ::new (static_cast<void*>(to)) T(_get<T>(from));
+        else
+            ::new (static_cast<void*>(to)) T*(new T(_get<T>(from)));
+    }
+
+    template<typename T>
+    static void _move(std::byte* from, std::byte* to) noexcept {
+        if constexpr (_is_local<T>) {
+            T& source = *std::launder(reinterpret_cast<T*>(from));
+            ::new (static_cast<void*>(to)) T(std::move(source));
+            source.~T();
+        } else {
+            ::new (static_cast<void*>(to)) T*(*std::launder(reinterpret_cast<T**>(from)));
+        }
+    }
+
+    template<typename T>
+    static void _destroy(std::byte* buffer) noexcept {
+        if constexpr (_is_local<T>)
+            std::launder(reinterpret_cast<T*>(buffer))->~T();
+        else
+            delete *std::launder(reinterpret_cast<T**>(buffer));
+    }
+
+    template<typename T>
+    static constexpr vtable _vtable_for{
+        .evaluate = &_evaluate<T>,
+        .value_and_grad = &_value_and_grad<T>,
+        .export_to = &_export_to<T>,
+        .copy = &_copy<T>,
+        .move = &_move<T>,
+        .destroy = &_destroy<T>
+    };
+
+    const vtable& _table() const {
+        if (!_vtable)
+            throw std::invalid_argument("Cannot evaluate an empty expression");
+        return *_vtable;
+    }
+
+    static std::size_t _num_points(std::span<const R> points, std::span<R> values) {
+        if (points.size()%arity != 0)
+            throw std::invalid_argument("Number of point coordinates is not a multiple of the number of symbols");
+        const std::size_t n = points.size()/arity;
+        if (values.size() < n)
+            throw std::invalid_argument("Value buffer is too small");
+        return n;
+    }
+
+    void _reset() noexcept {
+        if (_vtable)
+            std::exchange(_vtable, nullptr)->destroy(_buffer);
+    }
+
+    alignas(std::max_align_t) std::byte _buffer[buffer_size];
+    const vtable* _vtable = nullptr;
+};
+
+}  // namespace adpp::backward
@@ -1,15 +1,24 @@
 #pragma once
 
+#include <tuple>
 #include <utility>
 #include <concepts>
 #include <type_traits>
 
 #include <adpp/common.hpp>
 #include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
 #include <adpp/backward/concepts.hpp>
 
 namespace adpp::backward {
 
+template<typename S, typename V>
+struct value_binder;
+
+#ifndef DOXYGEN
+namespace detail { struct bound_expression_access; }
+#endif  // DOXYGEN
+
 #ifndef DOXYGEN
 namespace detail {
 
@@ -18,6 +27,18 @@ namespace detail {
     template<typename... B>
     inline constexpr bool are_binders = std::conjunction_v<is_value_binder<std::remove_cvref_t<B>>...>;
 
+    // array-valued bindings (e.g. vectors or matrices) contribute their scalar type
+    template<typename T>
+    struct scalar_value_type : std::type_identity<T> {};
+    template<typename T> requires(requires { std::tuple_size<T>::value; typename T::value_type; })
+    struct scalar_value_type<T> : scalar_value_type<typename T::value_type> {};
+
+    // bindings to values without a common type (e.g. to runtime nodes and scalars) have none
+    template<typename... T>
+    struct common_value_type : std::type_identity<void> {};
+    template<typename... T> requires(requires { typename std::common_type<T...>::type; })
+    struct common_value_type<T...> : std::common_type<T...> {};
+
 }  // namespace detail
 #endif  // DOXYGEN
 
@@ -30,32 +51,21 @@ struct bindings : variadic_accessor<B...> {
     template<typename T>
     using symbol_type_of = typename std::remove_cvref_t<T>::symbol_type;
 
-    template<typename T, typename... Bs>
-    struct binder_type_for;
-
-    template<typename T, typename B0, typename... Bs>
-    struct binder_type_for<T, B0, Bs...> {
-        using type = std::conditional_t<
-            same_remove_cvref_t_as<T, symbol_type_of<B0>>, B0, typename binder_type_for<T, Bs...>::type
-        >;
-    };
-
-    template<typename T>
-    struct binder_type_for<T> {
-        using type = void;
-    };
-
     template<typename T>
-    struct is_contained : std::disjunction<std::is_same<std::remove_cvref_t<T>, symbol_type_of<B>>...> {};
+    struct is_contained : is_any_of<std::remove_cvref_t<T>, symbol_type_of<B>...> {};
 
+    // position of the (first) binder for the given symbol
     template<typename T> requires(sizeof...(B) > 0 and is_contained<T>::value)
-    using binder_type = binder_type_for<T, B...>::type;
+    static constexpr std::size_t binder_index = index_of_type_v<std::remove_cvref_t<T>, symbol_type_of<B>...>;
 
  public:
     template<typename... T>
     static constexpr bool contains_bindings_for = std::conjunction_v<is_contained<T>...>;
 
-    using common_value_type = std::common_type_t<typename std::remove_cvref_t<B>::value_type...>;
+    using bound_symbols = type_list<symbol_type_of<B>...>;
+    using common_value_type = typename detail::common_value_type<
+        typename detail::scalar_value_type<typename std::remove_cvref_t<B>::value_type>::type...
+    >::type;
 
     constexpr bindings(B... binders) noexcept
     : base(std::forward<B>(binders)...)
@@ -65,7 +75,7 @@ struct bindings : variadic_accessor<B...> {
     template<typename Self, typename T>
         requires(contains_bindings_for<T>)
     constexpr decltype(auto) get(this Self&& self) noexcept {
-        return self.get(self.template index_of<binder_type<T>>()).unwrap();
+        return self.get(index_constant<binder_index<T>>{}).unwrap();
     }
 
     template<typename Self, typename T>
@@ -80,6 +90,7 @@ struct bindings<> {
     template<typename... T>
     static constexpr bool contains_bindings_for = false;
 
+    using bound_symbols = type_list<>;
     using common_value_type = double;
 };
 
@@ -94,6 +105,51 @@ struct is_binding<bindings<B...>> : std::true_type {};
 template<typename T>
 inline constexpr bool is_binding_v = is_binding<T>::value;
 
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename... A, typename... C, std::size_t... IA, std::size_t... IC>
+    inline constexpr auto concatenated(const bindings<A...>& a,
+                                       const bindings<C...>& c,
+                                       const std::index_sequence<IA...>&,
+                                       const std::index_sequence<IC...>&) {
+        return bindings<std::remove_cvref_t<A>..., std::remove_cvref_t<C>...>{
+            a.get(index_constant<IA>{})..., c.get(index_constant<IC>{})...
+        };
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename... A, typename... C>
+inline constexpr auto concatenated(const bindings<A...>& a, const bindings<C...>& c) {
+    return detail::concatenated(a, c, std::index_sequence_for<A...>{}, std::index_sequence_for<C...>{});
+}
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // binders of symbols to sub-expressions, i.e. intermediates that are evaluated once per sweep
+    template<typename T>
+    struct is_intermediate_binder : std::bool_constant<is_expression_v<typename std::remove_cvref_t<T>::value_type>> {};
+
+    template<typename... B>
+    inline constexpr bool has_intermediates = std::disjunction_v<is_intermediate_binder<B>...>;
+
+    template<typename B>
+    struct binds_intermediates : std::false_type {};
+    template<typename... B>
+    struct binds_intermediates<bindings<B...>> : std::bool_constant<has_intermediates<B...>> {};
+
+    // evaluates, back-propagates and differentiates expressions with intermediates (defined in expression.hpp)
+    template<typename... B>
+    struct intermediates;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 template<term E, typename B>
 class bound_expression {
  public:
@@ -102,13 +158,41 @@ class bound_expression {
     , _bindings{std::forward<B>(b)}
     {}
 
-    constexpr decltype(auto) evaluate() const requires(expression_for<E, B>) {
-        return _expression.get().evaluate(_bindings.get());
+    constexpr decltype(auto) evaluate() const
+        requires(detail::binds_intermediates<std::remove_cvref_t<B>>::value or expression_for<E, B>) {
+        return _evaluate(_expression.get(), _bindings.get());
+    }
+
+    // evaluate with additional bindings for the symbols that are not bound in this expression
+    template<typename... _B>
+    constexpr auto evaluate(const bindings<_B...>& b) const {
+        return _evaluate(_expression.get(), concatenated(_bindings.get(), b));
+    }
+
+    template<typename... _B>
+    constexpr auto operator()(const bindings<_B...>& b) const {
+        return evaluate(b);
+    }
+
+    template<typename... _B>
+        requires(sizeof...(_B) != 1 or !is_binding_v<std::remove_cvref_t<_B>...>)
+    constexpr auto operator()(_B&&... values) const {
+        return evaluate(at(std::forward<_B>(values)...));
     }
 
     template<scalar R, typename Self, typename... V>
     constexpr auto back_propagate(this Self&& self, const type_list<V...>& vars) {
-        auto [value, derivs] = self._expression.get().template back_propagate<R>(self._bindings.get(), vars);
+        auto [value, derivs] = _back_propagate<R>(self._expression.get(), self._bindings.get(), vars);
+        if constexpr (contains_decayed_v<Self, V...>)
+            derivs[self] = 1.0;
+        return std::make_pair(std::move(value), std::move(derivs));
+    }
+
+    template<scalar R, typename Self, typename... _B, typename... V>
+    constexpr auto back_propagate(this Self&& self, const bindings<_B...>& b, const type_list<V...>& vars) {
+        auto [value, derivs] = _back_propagate<R>(
+            self._expression.get(), concatenated(self._bindings.get(), b), vars
+        );
         if constexpr (contains_decayed_v<Self, V...>)
             derivs[self] = 1.0;
         return std::make_pair(std::move(value), std::move(derivs));
@@ -116,7 +200,9 @@ class bound_expression {
 
     template<typename Self, typename V>
     constexpr auto differentiate(this Self&& self, const type_list<V>& var) {
-        if constexpr (std::is_lvalue_reference_v<Self>)
+        if constexpr (detail::binds_intermediates<std::remove_cvref_t<B>>::value)
+            return _differentiate_substituted(self._expression.get(), self._bindings.get(), var);
+        else if constexpr (std::is_lvalue_reference_v<Self>)
             return _make(self._expression.get().differentiate(var), self._bindings.get());
         else
             return _make(
@@ -135,11 +221,36 @@ class bound_expression {
     }
 
  private:
+    // symbols bound to sub-expressions are resolved once per sweep before evaluating the expression
+    template<typename _E, typename... _B>
+    static constexpr decltype(auto) _evaluate(const _E& e, const bindings<_B...>& b) {
+        if constexpr (detail::has_intermediates<_B...>)
+            return detail::intermediates<_B...>::evaluate(e, b);
+        else
+            return e.evaluate(b);
+    }
+
+    template<scalar R, typename _E, typename... _B, typename... V>
+    static constexpr auto _back_propagate(const _E& e, const bindings<_B...>& b, const type_list<V...>& vars) {
+        if constexpr (detail::has_intermediates<_B...>)
+            return detail::intermediates<_B...>::template back_propagate<R>(e, b, vars);
+        else
+            return e.template back_propagate<R>(b, vars);
+    }
+
+    // symbols bound to sub-expressions are substituted, such that their derivatives are chained symbolically
+    template<typename _E, typename... _B, typename V>
+    static constexpr auto _differentiate_substituted(const _E& e, const bindings<_B...>& b, const type_list<V>& var) {
+        return detail::intermediates<_B...>::differentiate(e, b, var);
+    }
+
     template<typename _E, typename _B>
     static constexpr auto _make(_E&& e, _B&& b) {
         return bound_expression<_E, _B>{std::forward<_E>(e), std::forward<_B>(b)};
     }
 
+    friend struct detail::bound_expression_access;
+
     storage<E> _expression;
     storage<B> _bindings;
 };
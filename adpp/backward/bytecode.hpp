@@ -0,0 +1,289 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/tape.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename op> struct opcode_of;
+    template<> struct opcode_of<op::add> : std::integral_constant<opcode, opcode::add> {};
+    template<> struct opcode_of<op::subtract> : std::integral_constant<opcode, opcode::subtract> {};
+    template<> struct opcode_of<op::multiply> : std::integral_constant<opcode, opcode::multiply> {};
+    template<> struct opcode_of<op::divide> : std::integral_constant<opcode, opcode::divide> {};
+    template<> struct opcode_of<op::exp> : std::integral_constant<opcode, opcode::exp> {};
+
+    template<typename T>
+    struct is_bytecode_constant : std::negation<is_unbound_symbol<std::remove_cvref_t<T>>> {};
+
+    template<typename T, typename... R>
+    inline constexpr auto register_of = static_cast<std::uint32_t>(index_in<T, R...>);
+
+    template<typename R>
+    struct node_instruction;
+    template<typename... R>
+    struct node_instruction<type_list<R...>> {
+        template<typename op, typename A, typename B>
+        static constexpr instruction make(const expression<op, A, B>&) noexcept {
+            return {opcode_of<op>::value, register_of<A, R...>, register_of<B, R...>};
+        }
+
+        template<typename op, typename A>
+        static constexpr instruction make(const expression<op, A>&) noexcept {
+            return {opcode_of<op>::value, register_of<A, R...>, register_of<A, R...>};
+        }
+    };
+
+    // Registers are laid out as inputs, constants and the distinct expression nodes in post-order,
+    // such that each instruction writes to the register with its own index and the root comes last.
+    template<typename E, typename I = unbound_symbols_t<E>>
+    struct bytecode_layout {
+        using inputs = I;
+        static_assert(
+            [] <typename... S> (const type_list<S...>&) { return (is_any_of_v<S, I> and ...); } (unbound_symbols_t<E>{}),
+            "All unbound symbols of the expression must be inputs of the bytecode"
+        );
+
+        using constants = filtered_types_t<is_bytecode_constant, symbols_t<E>>;
+        using nodes = typename expression_nodes<E, type_list<>>::type;
+        using registers = merged_types_t<inputs, constants, nodes>;
+
+        static constexpr auto instructions = [] <std::size_t... i, std::size_t... c, typename... N> (
+            const std::index_sequence<i...>&,
+            const std::index_sequence<c...>&,
+            const type_list<N...>&
+        ) {
+            return std::array<instruction, sizeof...(i) + sizeof...(c) + sizeof...(N)>{
+                instruction{opcode::input, static_cast<std::uint32_t>(i), 0}...,
+                instruction{opcode::constant, static_cast<std::uint32_t>(c), 0}...,
+                node_instruction<registers>::make(N{})...
+            };
+        } (
+            std::make_index_sequence<type_list_size_v<inputs>>{},
+            std::make_index_sequence<type_list_size_v<constants>>{},
+            nodes{}
+        );
+    };
+
+    template<typename T>
+    inline void write_binary(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    inline T read_binary(std::istream& in) {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw std::invalid_argument("Unexpected end of bytecode stream");
+        return value;
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// Instructions of the bytecode for the given expression, computed at compile time. The inputs
+// are the unbound symbols of the expression, in the order given by `unbound_symbols_t<E>`.
+template<typename E> requires(is_expression_v<std::remove_cvref_t<E>>)
+inline constexpr auto bytecode_instructions_v = detail::bytecode_layout<
+    typename detail::unwrapped<std::remove_cvref_t<E>>::type
+>::instructions;
+
+
+// Compact, serializable representation of an expression, evaluated and differentiated by a register-based
+// interpreter. Each instruction writes the register with its own index, and the last register holds the result.
+// Since the interpreter does not depend on the expression type, bytecode loaded from a file does not require
+// any template instantiations for the expression it represents.
+template<scalar R = double>
+class bytecode {
+ public:
+    using value_type = R;
+    using index_type = std::uint32_t;
+
+    static constexpr std::array<char, 4> magic{'a', 'd', 'b', 'c'};
+    static constexpr std::uint32_t version = 1;
+
+    bytecode(std::vector<instruction> instructions, std::vector<R> constants, index_type num_inputs)
+    : _instructions{std::move(instructions)}
+    , _constants{std::move(constants)}
+    , _num_inputs{num_inputs} {
+        if (_instructions.empty())
+            throw std::invalid_argument("Bytecode must contain at least one instruction");
+        for (std::size_t i = 0; i < _instructions.size(); ++i)
+            _validate(_instructions[i], i);
+        _registers.resize(_instructions.size());
+    }
+
+    constexpr std::size_t size() const noexcept { return _instructions.size(); }
+    constexpr std::size_t num_inputs() const noexcept { return _num_inputs; }
+    constexpr std::span<const instruction> instructions() const noexcept { return _instructions; }
+    constexpr std::span<const R> constants() const noexcept { return _constants; }
+
+    R evaluate(std::span<const R> inputs) {
+        if (inputs.size() != _num_inputs)
+            throw std::invalid_argument("Number of input values does not match the number of bytecode inputs");
+
+        const instruction* code = _instructions.data();
+        R* registers = _registers.data();
+        for (std::size_t i = 0; i < _instructions.size(); ++i) {
+            const instruction& instr = code[i];
+            switch (instr.code) {
+                case opcode::input: registers[i] = inputs[instr.lhs]; break;
+                case opcode::constant: registers[i] = _constants[instr.lhs]; break;
+                default: registers[i] = detail::apply(instr.code, registers[instr.lhs], registers[instr.rhs]);
+            }
+        }
+        return registers[_instructions.size() - 1];
+    }
+
+    // evaluates the bytecode and writes the derivatives w.r.t. all inputs into the given buffer
+    R value_and_grad(std::span<const R> inputs, std::span<R> gradient) {
+        if (gradient.size() < _num_inputs)
+            throw std::invalid_argument("Gradient buffer is too small");
+
+        const R result = evaluate(inputs);
+        const R* registers = _registers.data();
+        _adjoints.assign(_instructions.size(), R{0});
+        std::fill_n(gradient.begin(), _num_inputs, R{0});
+        _adjoints.back() = R{1};
+        for (std::size_t i = _instructions.size(); i-- > 0;) {
+            const R adjoint = _adjoints[i];
+            const instruction& instr = _instructions[i];
+            switch (instr.code) {
+                case opcode::input: gradient[instr.lhs] += adjoint; break;
+                case opcode::constant: break;
+                default: detail::propagate_adjoint(
+                    instr.code, adjoint, registers[instr.lhs], registers[instr.rhs], registers[i],
+                    _adjoints[instr.lhs], _adjoints[instr.rhs]
+                );
+            }
+        }
+        return result;
+    }
+
+    // Binary format: magic, version, size of the value type, number of inputs, instructions and constants,
+    // followed by the instructions and the constants. Values are stored in the native byte order.
+    void write(std::ostream& out) const {
+        out.write(magic.data(), magic.size());
+        detail::write_binary(out, version);
+        detail::write_binary(out, static_cast<std::uint32_t>(sizeof(R)));
+        detail::write_binary(out, _num_inputs);
+        detail::write_binary(out, static_cast<std::uint32_t>(_instructions.size()));
+        detail::write_binary(out, static_cast<std::uint32_t>(_constants.size()));
+        for (const instruction& instr : _instructions) {
+            detail::write_binary(out, instr.code);
+            detail::write_binary(out, instr.lhs);
+            detail::write_binary(out, instr.rhs);
+        }
+        for (const R& value : _constants)
+            detail::write_binary(out, value);
+    }
+
+    static bytecode read(std::istream& in) {
+        if (detail::read_binary<std::array<char, 4>>(in) != magic)
+            throw std::invalid_argument("Stream does not contain bytecode");
+        if (detail::read_binary<std::uint32_t>(in) != version)
+            throw std::invalid_argument("Unsupported bytecode version");
+        if (detail::read_binary<std::uint32_t>(in) != sizeof(R))
+            throw std::invalid_argument("Bytecode has been written with a different value type");
+
+        const auto num_inputs = detail::read_binary<index_type>(in);
+        const auto num_instructions = detail::read_binary<std::uint32_t>(in);
+        const auto num_constants = detail::read_binary<std::uint32_t>(in);
+
+        // the counts are untrusted, so the vectors only grow with the elements actually read from the stream
+        constexpr std::uint32_t max_reserved = 4096;
+        std::vector<instruction> instructions;
+        std::vector<R> constants;
+        instructions.reserve(std::min(num_instructions, max_reserved));
+        constants.reserve(std::min(num_constants, max_reserved));
+        for (std::uint32_t i = 0; i < num_instructions; ++i) {
+            const auto code = detail::read_binary<opcode>(in);
+            const auto lhs = detail::read_binary<index_type>(in);
+            const auto rhs = detail::read_binary<index_type>(in);
+            instructions.push_back(instruction{code, lhs, rhs});
+        }
+        for (std::uint32_t i = 0; i < num_constants; ++i)
+            constants.push_back(detail::read_binary<R>(in));
+        return bytecode{std::move(instructions), std::move(constants), num_inputs};
+    }
+
+ private:
+    void _validate(const instruction& instr, std::size_t i) const {
+        const auto in_range = [] (std::size_t index, std::size_t size) {
+            if (index >= size)
+                throw std::invalid_argument("Bytecode instruction refers to an invalid operand");
+        };
+
+        switch (instr.code) {
+            case opcode::input: in_range(instr.lhs, _num_inputs); break;
+            case opcode::constant: in_range(instr.lhs, _constants.size()); break;
+            case opcode::add:
+            case opcode::subtract:
+            case opcode::multiply:
+            case opcode::divide:
+            case opcode::exp:
+                in_range(instr.lhs, i);
+                in_range(instr.rhs, i);
+                break;
+            default: throw std::invalid_argument("Unsupported bytecode instruction");
+        }
+    }
+
+    std::vector<instruction> _instructions;
+    std::vector<R> _constants;
+    std::vector<R> _registers;
+    std::vector<R> _adjoints;
+    index_type _num_inputs;
+};
+
+
+// Translates the given expression into bytecode. The structure is computed at compile time,
+// while the constant pool is filled with the current values of the constants (e.g. of `val`s).
+// The inputs are the given symbols, in the order in which they were passed to `wrt`.
+template<scalar R = double, typename E, typename... I>
+    requires(is_expression_v<std::remove_cvref_t<E>> and are_unique_v<I...>)
+inline bytecode<R> to_bytecode(const E&, const type_list<I...>& inputs) {
+    using layout = detail::bytecode_layout<typename detail::unwrapped<std::remove_cvref_t<E>>::type, type_list<I...>>;
+    constexpr auto instructions = layout::instructions;
+    return [&] <typename... C> (const type_list<C...>&) {
+        return bytecode<R>{
+            std::vector<instruction>(instructions.begin(), instructions.end()),
+            std::vector<R>{static_cast<R>(C{}.evaluate(bindings<>{}))...},
+            static_cast<std::uint32_t>(sizeof...(I))
+        };
+    } (typename layout::constants{});
+}
+
+// overload that uses all unbound symbols of the expression as inputs, in the order given by `unbound_symbols_t<E>`
+template<scalar R = double, typename E> requires(is_expression_v<std::remove_cvref_t<E>>)
+inline bytecode<R> to_bytecode(const E& e) {
+    return to_bytecode<R>(e, unbound_symbols_t<typename detail::unwrapped<std::remove_cvref_t<E>>::type>{});
+}
+
+#ifdef ADPP_EXTERN_TEMPLATES
+// instantiated in the object file of the adpp module (see ADPP_BUILD_MODULE)
+extern template class bytecode<double>;
+#endif
+
+}  // namespace adpp::backward
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adpp/common.hpp>
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/derivatives.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // number of steps that can be reversed with the given number of checkpoints and repetitions
+    inline constexpr std::uint64_t binomial_steps(std::size_t checkpoints, std::size_t repetitions) noexcept {
+        std::uint64_t result = 1;
+        for (std::size_t i = 1; i <= repetitions; ++i) {
+            if (result > std::numeric_limits<std::uint64_t>::max()/(checkpoints + i))
+                return std::numeric_limits<std::uint64_t>::max();
+            result = result*(checkpoints + i)/i;
+        }
+        return result;
+    }
+
+    // length of the first segment when splitting n steps in the binomial (Revolve) schedule
+    inline constexpr std::size_t binomial_split(std::size_t steps, std::size_t checkpoints) noexcept {
+        std::size_t repetitions = 0;
+        while (binomial_steps(checkpoints, repetitions) < steps)
+            ++repetitions;
+        const std::uint64_t rest = binomial_steps(checkpoints - 1, repetitions);
+        const std::size_t first = rest < steps ? static_cast<std::size_t>(steps - rest) : 1;
+        return std::clamp<std::size_t>(first, 1, steps - 1);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+
+struct checkpointing_statistics {
+    std::size_t forward_steps = 0;     // number of evaluated steps, including recomputations
+    std::size_t adjoint_steps = 0;     // number of reversed steps
+    std::size_t max_checkpoints = 0;   // peak number of simultaneously stored states
+};
+
+
+// Driver for reverse-mode differentiation through time-stepping loops. The step is given as bindings of the
+// state variables to the expressions for their values after one step, e.g. `bind(x = x + dt*v, v = v - dt*x)`.
+// During the reverse sweep, only the given number of intermediate states is stored, and the remaining states
+// are recomputed from these checkpoints following the binomial schedule of Revolve (Griewank & Walther).
+template<typename S, typename P = bindings<>, scalar R = double>
+class time_stepper;
+
+template<typename... B, typename P, scalar R>
+class time_stepper<bindings<B...>, P, R> {
+    template<typename T>
+    using symbol_type_of = typename std::remove_cvref_t<T>::symbol_type;
+
+    using vars = type_list<symbol_type_of<B>...>;
+    static constexpr std::size_t N = sizeof...(B);
+    static_assert(((value_extent_v<symbol_type_of<B>> == 1) and ...), "Time steppers only support scalar-valued states");
+
+ public:
+    using value_type = R;
+    using state_type = std::array<R, N>;
+
+    constexpr time_stepper(bindings<B...> step, std::size_t checkpoints)
+    requires(std::is_same_v<P, bindings<>>)
+    : time_stepper(std::move(step), P{}, checkpoints)
+    {}
+
+    constexpr time_stepper(bindings<B...> step, P parameters, std::size_t checkpoints)
+    : _step{std::move(step)}
+    , _parameters{std::move(parameters)}
+    , _checkpoints{checkpoints}
+    {}
+
+    // advance the given state by one step
+    constexpr state_type step(const state_type& x) const {
+        const auto b = _bind(x);
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return state_type{static_cast<R>(_step.get(index_constant<i>{}).unwrap().evaluate(b))...};
+        } (std::make_index_sequence<N>{});
+    }
+
+    // given the adjoint of the state after a step, compute the adjoint of the state x before it
+    constexpr state_type adjoint_step(const state_type& x, const state_type& adjoint) const {
+        const auto b = _bind(x);
+        state_type result{};
+        [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            (_accumulate_adjoint(_step.get(index_constant<i>{}).unwrap(), b, adjoint[i], result), ...);
+        } (std::make_index_sequence<N>{});
+        return result;
+    }
+
+    constexpr state_type integrate(state_type x, std::size_t steps) const {
+        for (std::size_t i = 0; i < steps; ++i)
+            x = step(x);
+        return x;
+    }
+
+    // Run the given number of steps and reverse them, seeding the adjoint of the final state with the
+    // result of `seed(final_state)`. Returns the final state and the adjoint of the initial state.
+    template<typename Seed>
+    constexpr std::pair<state_type, state_type> reverse(const state_type& initial, std::size_t steps, Seed&& seed) {
+        _statistics = {};
+        if (steps == 0)
+            return {initial, seed(initial)};
+
+        sweep_state sweep{.steps = steps};
+        _treeverse(initial, 0, steps, _checkpoints, sweep, seed);
+        return {sweep.final_state, sweep.adjoint};
+    }
+
+    // value and gradient of an objective, given as an expression of the final state, w.r.t. the initial state
+    template<term O>
+    constexpr std::pair<R, state_type> value_and_grad(const O& objective, const state_type& initial, std::size_t steps) {
+        R value{};
+        const state_type adjoint = reverse(initial, steps, [&] (const state_type& final_state) {
+            auto [v, derivs] = objective.template back_propagate<R>(_bind(final_state), vars{});
+            value = static_cast<R>(v);
+            return derivs.as_array();
+        }).second;
+        return {value, adjoint};
+    }
+
+    constexpr std::size_t checkpoints() const noexcept { return _checkpoints; }
+    constexpr const checkpointing_statistics& statistics() const noexcept { return _statistics; }
+
+ private:
+    struct sweep_state {
+        std::size_t steps;
+        std::size_t stored = 0;
+        state_type final_state{};
+        state_type adjoint{};
+    };
+
+    constexpr auto _bind(const state_type& x) const {
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            using state_bindings = bindings<value_binder<symbol_type_of<B>, R>...>;
+            return concatenated(
+                state_bindings{value_binder<symbol_type_of<B>, R>{symbol_type_of<B>{}, x[i]}...},
+                _parameters
+            );
+        } (std::make_index_sequence<N>{});
+    }
+
+    template<typename E, typename _B>
+    constexpr void _accumulate_adjoint(const E& e, const _B& b, R adjoint, state_type& result) const {
+        const auto derivs = e.template back_propagate<R>(b, vars{}).second;
+        for (std::size_t j = 0; j < N; ++j)
+            result[j] += adjoint*derivs.as_array()[j];
+    }
+
+    // reverses the steps [begin, end) starting from the (checkpointed) state x at step `begin`
+    template<typename Seed>
+    constexpr void _treeverse(const state_type& x,
+                              std::size_t begin,
+                              std::size_t end,
+                              std::size_t free_checkpoints,
+                              sweep_state& sweep,
+                              Seed& seed) {
+        if (end - begin == 1) {
+            if (end == sweep.steps) {
+                sweep.final_state = step(x);
+                sweep.adjoint = seed(sweep.final_state);
+                ++_statistics.forward_steps;
+            }
+            sweep.adjoint = adjoint_step(x, sweep.adjoint);
+            ++_statistics.adjoint_steps;
+            return;
+        }
+
+        if (free_checkpoints == 0) {
+            for (std::size_t last = end; last > begin; --last)
+                _treeverse(_advance(x, last - 1 - begin), last - 1, last, 0, sweep, seed);
+            return;
+        }
+
+        const std::size_t middle = begin + detail::binomial_split(end - begin, free_checkpoints);
+        {
+            const state_type checkpoint = _advance(x, middle - begin);
+            ++sweep.stored;
+            _statistics.max_checkpoints = std::max(_statistics.max_checkpoints, sweep.stored);
+            _treeverse(checkpoint, middle, end, free_checkpoints - 1, sweep, seed);
+            --sweep.stored;
+        }
+        _treeverse(x, begin, middle, free_checkpoints, sweep, seed);
+    }
+
+    constexpr state_type _advance(state_type x, std::size_t steps) {
+        _statistics.forward_steps += steps;
+        return integrate(std::move(x), steps);
+    }
+
+    bindings<B...> _step;
+    P _parameters;
+    std::size_t _checkpoints;
+    checkpointing_statistics _statistics;
+};
+
+template<typename... B>
+time_stepper(bindings<B...>, std::size_t) -> time_stepper<bindings<B...>>;
+
+template<typename... B, typename P>
+time_stepper(bindings<B...>, P, std::size_t) -> time_stepper<bindings<B...>, P>;
+
+}  // namespace adpp::backward
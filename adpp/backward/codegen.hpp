@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+#include <charconv>
+#include <concepts>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/tape.hpp>
+#include <adpp/backward/bytecode.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename R> struct cpp_type_name;
+    template<> struct cpp_type_name<float> {
+        static constexpr std::string_view value = "float";
+        static constexpr std::string_view literal_suffix = "f";
+    };
+    template<> struct cpp_type_name<double> {
+        static constexpr std::string_view value = "double";
+        static constexpr std::string_view literal_suffix = "";
+    };
+    template<> struct cpp_type_name<long double> {
+        static constexpr std::string_view value = "long double";
+        static constexpr std::string_view literal_suffix = "L";
+    };
+
+    inline constexpr bool is_identifier(std::string_view name) noexcept {
+        const auto is_alpha = [] (char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; };
+        if (name.empty() || !is_alpha(name.front()))
+            return false;
+        for (char c : name)
+            if (!is_alpha(c) && !(c >= '0' && c <= '9'))
+                return false;
+        return true;
+    }
+
+    // shortest representation that parses back to the same value, as a literal of type R
+    template<std::floating_point R>
+    inline std::string cpp_literal(R value) {
+        if (value != value || value - value != R{0})
+            throw std::invalid_argument("Generated code can only contain finite constants");
+        std::array<char, 64> buffer;
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        std::string literal{buffer.data(), result.ptr};
+
+        // integral representations would otherwise be integer literals (e.g. 1f is ill-formed, 1L is a long)
+        constexpr auto suffix = cpp_type_name<R>::literal_suffix;
+        if (!suffix.empty()) {
+            if (literal.find_first_of(".e") == std::string::npos)
+                literal += ".0";
+            literal += suffix;
+        }
+        return literal;
+    }
+
+    template<std::floating_point R>
+    inline void write_value_signature(std::ostream& out, std::string_view name) {
+        if (!is_identifier(name))
+            throw std::invalid_argument("Kernel name is not a valid identifier");
+        constexpr auto type = cpp_type_name<R>::value;
+        out << type << " " << name << "(const " << type << "* input)";
+    }
+
+    template<std::floating_point R>
+    inline void write_gradient_signature(std::ostream& out, std::string_view name) {
+        if (!is_identifier(name))
+            throw std::invalid_argument("Kernel name is not a valid identifier");
+        constexpr auto type = cpp_type_name<R>::value;
+        out << type << " " << name << "_gradient(const " << type << "* input, " << type << "* gradient)";
+    }
+
+    template<std::floating_point R>
+    inline void write_forward_sweep(std::ostream& out, const bytecode<R>& code) {
+        constexpr auto type = cpp_type_name<R>::value;
+        const auto instructions = code.instructions();
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const instruction& instr = instructions[i];
+            out << "    const " << type << " t" << i << " = ";
+            switch (instr.code) {
+                case opcode::input: out << "input[" << instr.lhs << "]"; break;
+                case opcode::constant: out << cpp_literal(code.constants()[instr.lhs]); break;
+                case opcode::add: out << "t" << instr.lhs << " + t" << instr.rhs; break;
+                case opcode::subtract: out << "t" << instr.lhs << " - t" << instr.rhs; break;
+                case opcode::multiply: out << "t" << instr.lhs << "*t" << instr.rhs; break;
+                case opcode::divide: out << "t" << instr.lhs << "/t" << instr.rhs; break;
+                case opcode::exp: out << "std::exp(t" << instr.lhs << ")"; break;
+                default: throw std::invalid_argument("Unsupported instruction in generated code");
+            }
+            out << ";\n";
+        }
+    }
+
+    template<std::floating_point R>
+    inline void write_reverse_sweep(std::ostream& out, const bytecode<R>& code) {
+        constexpr auto type = cpp_type_name<R>::value;
+        const auto instructions = code.instructions();
+        const std::size_t root = instructions.size() - 1;
+
+        // only registers that depend on inputs carry adjoints
+        std::vector<bool> active(instructions.size(), false);
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const instruction& instr = instructions[i];
+            if (instr.code == opcode::input)
+                active[i] = true;
+            else if (instr.code != opcode::constant)
+                active[i] = active[instr.lhs] || active[instr.rhs];
+        }
+
+        for (std::size_t i = 0; i < code.num_inputs(); ++i)
+            out << "    gradient[" << i << "] = 0;\n";
+        if (!active[root])
+            return;
+
+        for (std::size_t i = 0; i < instructions.size(); ++i)
+            if (active[i])
+                out << "    " << type << " a" << i << " = " << (i == root ? "1" : "0") << ";\n";
+
+        for (std::size_t i = root + 1; i-- > 0;) {
+            if (!active[i])
+                continue;
+
+            const instruction& instr = instructions[i];
+            const auto accumulate = [&] (std::size_t target, std::string_view op, const auto&... factors) {
+                if (!active[target])
+                    return;
+                out << "    a" << target << " " << op << " a" << i;
+                ((out << factors), ...);
+                out << ";\n";
+            };
+
+            switch (instr.code) {
+                case opcode::input: out << "    gradient[" << instr.lhs << "] += a" << i << ";\n"; break;
+                case opcode::add:
+                    accumulate(instr.lhs, "+=");
+                    accumulate(instr.rhs, "+=");
+                    break;
+                case opcode::subtract:
+                    accumulate(instr.lhs, "+=");
+                    accumulate(instr.rhs, "-=");
+                    break;
+                case opcode::multiply:
+                    accumulate(instr.lhs, "+=", "*t", instr.rhs);
+                    accumulate(instr.rhs, "+=", "*t", instr.lhs);
+                    break;
+                case opcode::divide:
+                    accumulate(instr.lhs, "+=", "/t", instr.rhs);
+                    accumulate(instr.rhs, "-=", "*t", instr.lhs, "/(t", instr.rhs, "*t", instr.rhs, ")");
+                    break;
+                case opcode::exp:
+                    accumulate(instr.lhs, "+=", "*t", i);
+                    break;
+                default: break;
+            }
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// Writes a standalone C++ source file with the straight-line functions `R name(const R* input)` and
+// `R name_gradient(const R* input, R* gradient)`, which evaluate the given bytecode and its gradient
+// w.r.t. all inputs. Each distinct node is assigned a named temporary, such that common sub-expressions
+// are computed once, and the generated code contains no templates.
+template<std::floating_point R>
+inline void write_kernel_source(std::ostream& out, std::string_view name, const bytecode<R>& code) {
+    const std::size_t root = code.size() - 1;
+    out << "// Generated by adpp, do not edit\n";
+    out << "#include <cmath>\n\n";
+
+    detail::write_value_signature<R>(out, name);
+    out << " {\n";
+    detail::write_forward_sweep(out, code);
+    out << "    return t" << root << ";\n";
+    out << "}\n\n";
+
+    detail::write_gradient_signature<R>(out, name);
+    out << " {\n";
+    detail::write_forward_sweep(out, code);
+    detail::write_reverse_sweep(out, code);
+    out << "    return t" << root << ";\n";
+    out << "}\n";
+}
+
+template<std::floating_point R = double, typename E, typename... V>
+    requires(is_expression_v<std::remove_cvref_t<E>>)
+inline void write_kernel_source(std::ostream& out, std::string_view name, const E& e, const type_list<V...>& inputs) {
+    write_kernel_source(out, name, to_bytecode<R>(e, inputs));
+}
+
+// Writes a header with the declarations of the functions written by `write_kernel_source`.
+template<std::floating_point R = double>
+inline void write_kernel_header(std::ostream& out, std::string_view name) {
+    out << "// Generated by adpp, do not edit\n";
+    out << "#pragma once\n\n";
+    detail::write_value_signature<R>(out, name);
+    out << ";\n";
+    detail::write_gradient_signature<R>(out, name);
+    out << ";\n";
+}
+
+}  // namespace adpp::backward
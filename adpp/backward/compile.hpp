@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <concepts>
+#include <type_traits>
+
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/derivatives.hpp>
+
+namespace adpp::backward {
+
+template<term E, scalar R, typename... V>
+    requires(are_unique_v<V...> and std::conjunction_v<is_unbound_symbol<V>...>)
+struct compiled_function {
+ private:
+    // turns the symbol pack into a fixed parameter list of the value type
+    template<typename>
+    using arg_t = R;
+
+    // the arguments are wrapped into (fixed-type) bindings by value, whose lookups resolve at compile time and
+    // which are optimized away once inlined (binding them by reference instead yields more code)
+    static constexpr auto _bind(arg_t<V>... values) noexcept {
+        return bindings<value_binder<V, R>...>{value_binder<V, R>{V{}, std::move(values)}...};
+    }
+
+ public:
+    using value_type = R;
+    static constexpr std::size_t arity = sizeof...(V);
+
+    template<typename _E> requires(std::constructible_from<E, _E>)
+    constexpr compiled_function(_E&& e) noexcept
+    : _e{std::forward<_E>(e)}
+    {}
+
+    constexpr R operator()(arg_t<V>... values) const {
+        return static_cast<R>(_e.evaluate(_bind(values...)));
+    }
+
+    constexpr auto value_and_grad(arg_t<V>... values) const {
+        auto [value, derivs] = _e.template back_propagate<R>(_bind(values...), type_list<V...>{});
+        return std::make_pair(static_cast<R>(value), derivs.as_array());
+    }
+
+    // stateless entry points, e.g. to be passed as function pointers to C-style interfaces
+    static constexpr R invoke(arg_t<V>... values) requires(std::is_default_constructible_v<E>) {
+        return compiled_function{E{}}(values...);
+    }
+
+    static constexpr auto invoke_with_gradient(arg_t<V>... values) requires(std::is_default_constructible_v<E>) {
+        return compiled_function{E{}}.value_and_grad(values...);
+    }
+
+ private:
+    [[no_unique_address]] E _e;
+};
+
+template<scalar R = double, term E, typename... V>
+inline constexpr auto compile(E&& expression, const type_list<V...>&) {
+    return compiled_function<std::remove_cvref_t<E>, R, V...>{std::forward<E>(expression)};
+}
+
+}  // namespace adpp::backward
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 
 #include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
 
 namespace adpp::backward {
 
@@ -29,11 +31,19 @@ inline constexpr bool is_expression_v = is_expression<T>::value;
 template<typename T>
 concept term = symbolic<std::remove_cvref_t<T>> or is_expression_v<std::remove_cvref_t<T>>;
 template<typename T, typename Arg>
-concept expression_for = term<T> and requires(const T& t, const Arg& b) { { t.evaluate(b) }; };
+concept evaluatable_with = requires(const T& t, const Arg& b) { { t.evaluate(b) }; };
+template<typename T, typename Arg>
+concept expression_for = term<T> and evaluatable_with<T, Arg>;
 template<typename T>
 concept into_term = term<std::remove_cvref_t<T>> or scalar<std::remove_cvref_t<T>>;
 
 
+template<typename T>
+struct value_extent : index_constant<1> {};
+template<typename T>
+inline constexpr std::size_t value_extent_v = value_extent<std::remove_cvref_t<T>>::value;
+
+
 template<typename T>
 struct operands;
 template<typename T>
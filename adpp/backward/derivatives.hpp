@@ -3,34 +3,62 @@
 #include <algorithm>
 #include <type_traits>
 #include <array>
+#include <span>
 
 #include <adpp/common.hpp>
 #include <adpp/concepts.hpp>
+#include <adpp/backward/concepts.hpp>
 
 namespace adpp::backward {
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename... Ts>
+    inline constexpr auto value_offsets = [] () {
+        std::array<std::size_t, sizeof...(Ts)> offsets{};
+        std::array<std::size_t, sizeof...(Ts)> extents{value_extent_v<Ts>...};
+        for (std::size_t i = 1; i < sizeof...(Ts); ++i)
+            offsets[i] = offsets[i-1] + extents[i-1];
+        return offsets;
+    } ();
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 template<scalar R, typename... Ts>
     requires(are_unique_v<Ts...>)
 struct derivatives : indexed<const Ts&...> {
  private:
      using base = indexed<const Ts&...>;
 
+     template<std::size_t i, typename Self>
+     static constexpr decltype(auto) _entry(Self& self) noexcept {
+        using T = std::remove_cvref_t<type_at_t<i, Ts...>>;
+        constexpr std::size_t offset = detail::value_offsets<Ts...>[i];
+        if constexpr (value_extent_v<T> == 1)
+            return (self._values[offset]);
+        else
+            return std::span{self._values.data() + offset, value_extent_v<T>}.template first<value_extent_v<T>>();
+     }
+
  public:
     using value_type = R;
     static constexpr std::size_t size = sizeof...(Ts);
+    static constexpr std::size_t flat_size = (std::size_t{0} + ... + value_extent_v<Ts>);
 
     constexpr derivatives() noexcept {
         std::ranges::fill(_values, R{0});
     }
 
     template<typename Self, typename T> requires(contains_decayed_v<T, Ts...>)
-    constexpr std::convertible_to<value_type> decltype(auto) operator[](this Self&& self, const T& t) noexcept {
-        return self._values[self.index_of(t)];
+    constexpr decltype(auto) operator[](this Self&& self, const T& t) noexcept {
+        return _entry<decltype(self.index_of(t))::value>(self);
     }
 
     template<typename T> requires(contains_decayed_v<T, Ts...>)
-    constexpr std::convertible_to<value_type> decltype(auto) get() const noexcept {
-        return _values[base::template index_of<T>()];
+    constexpr decltype(auto) get() const noexcept {
+        return _entry<decltype(base::template index_of<T>())::value>(*this);
     }
 
     template<typename Self, scalar T>
@@ -60,7 +88,7 @@ struct derivatives : indexed<const Ts&...> {
     constexpr auto& as_array() noexcept { return _values; }
 
  private:
-    std::array<value_type, size> _values;
+    std::array<value_type, flat_size> _values;
 };
 
 }  // namespace adpp::backward
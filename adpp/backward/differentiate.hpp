@@ -1,10 +1,17 @@
 #pragma once
 
+#include <array>
+#include <ranges>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
 #include <type_traits>
 
 #include <adpp/common.hpp>
 #include <adpp/type_traits.hpp>
 #include <adpp/backward/bindings.hpp>
+#include <adpp/backward/derivatives.hpp>
+#include <adpp/backward/expression.hpp>
 
 namespace adpp::backward {
 
@@ -14,7 +21,7 @@ inline constexpr auto wrt(V&&...) {
 }
 
 template<typename R = automatic, typename E, typename... B, typename... V>
-    requires(expression_for<E, bindings<B...>>)
+    requires(evaluatable_with<E, bindings<B...>>)
 inline constexpr auto derivatives_of(E&& expression, const type_list<V...>& vars, const bindings<B...>& b) {
     using result_t = std::conditional_t<
         std::is_same_v<R, automatic>, typename bindings<B...>::common_value_type, R
@@ -33,6 +40,93 @@ inline constexpr auto grad(E&& expression, const bindings<B...>& bindings) {
 }
 
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    concept strided_vector_view = requires(T& t) {
+        { t.data() };
+        { t.size() } -> std::integral;
+        { t.innerStride() } -> std::integral;
+    };
+
+    template<typename T>
+    concept contiguous_output = std::ranges::contiguous_range<T>
+        and std::ranges::sized_range<T>
+        and !strided_vector_view<std::remove_cvref_t<T>>;
+
+    // The reverse sweep returns the derivatives by value from each node, so they are first accumulated in
+    // a `derivatives` object of the variables and then copied into the output (one copy, no allocation).
+    template<typename R, typename E, typename... B, typename... V, typename T>
+    inline constexpr void strided_derivatives_into(E&& expression,
+                                                   const bindings<B...>& bindings,
+                                                   const type_list<V...>& vars,
+                                                   T* out,
+                                                   std::size_t size,
+                                                   std::size_t stride) {
+        const auto derivs = derivatives_of<R>(std::forward<E>(expression), vars, bindings);
+        const auto& values = derivs.as_array();
+        if (size < values.size())
+            throw std::invalid_argument("Output buffer is too small to hold all derivatives");
+        for (std::size_t i = 0; i < values.size(); ++i)
+            out[i*stride] = values[i];
+    }
+
+    template<typename R, typename T>
+    using output_value_t = std::conditional_t<std::is_same_v<R, automatic>, std::remove_cvref_t<T>, R>;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// writes the derivatives into the given buffer, in the order in which the variables were passed to `wrt`
+// (they are accumulated in a `derivatives` object on the stack first, which is then copied into the buffer)
+template<typename R = automatic, typename E, typename... B, typename... V, typename O>
+    requires(detail::contiguous_output<O>)
+inline constexpr void grad_into(E&& expression, const bindings<B...>& bindings, const type_list<V...>& vars, O&& out) {
+    using result_t = detail::output_value_t<R, std::ranges::range_value_t<O>>;
+    detail::strided_derivatives_into<result_t>(
+        std::forward<E>(expression), bindings, vars, std::ranges::data(out), std::ranges::size(out), 1
+    );
+}
+
+// overload for (possibly strided) vector views such as `Eigen::Map`
+template<typename R = automatic, typename E, typename... B, typename... V, typename O>
+    requires(detail::strided_vector_view<std::remove_cvref_t<O>>)
+inline constexpr void grad_into(E&& expression, const bindings<B...>& bindings, const type_list<V...>& vars, O&& out) {
+    using result_t = detail::output_value_t<R, std::remove_pointer_t<decltype(out.data())>>;
+    detail::strided_derivatives_into<result_t>(
+        std::forward<E>(expression), bindings, vars,
+        out.data(), static_cast<std::size_t>(out.size()), static_cast<std::size_t>(out.innerStride())
+    );
+}
+
+// writes the derivatives into the given row of a dense (rows x variables) jacobian with the given layout,
+// copying them from a `derivatives` object on the stack as in `grad_into`
+template<typename R = automatic, typename E, typename... B, typename... V, typename O, typename L>
+    requires(detail::contiguous_output<O> and is_any_of_v<L, row_major, column_major>)
+inline constexpr void jacobian_row_into(E&& expression,
+                                        const bindings<B...>& bindings,
+                                        const type_list<V...>& vars,
+                                        O&& jacobian,
+                                        std::size_t row,
+                                        std::size_t rows,
+                                        const L&) {
+    using result_t = detail::output_value_t<R, std::ranges::range_value_t<O>>;
+    using derivatives_t = decltype(derivatives_of<result_t>(expression, vars, bindings));
+    constexpr std::size_t cols = derivatives_t::flat_size;
+    if (row >= rows || std::ranges::size(jacobian) < rows*cols)
+        throw std::invalid_argument("Jacobian row out of bounds");
+
+    constexpr bool is_row_major = std::is_same_v<L, row_major>;
+    const std::size_t offset = is_row_major ? row*cols : row;
+    const std::size_t stride = is_row_major ? 1 : rows;
+    detail::strided_derivatives_into<result_t>(
+        std::forward<E>(expression), bindings, vars,
+        std::ranges::data(jacobian) + offset, cols, stride
+    );
+}
+
+
 #ifndef DOXYGEN
 namespace detail {
 
@@ -59,4 +153,92 @@ inline constexpr auto differentiate(const E& expression, const type_list<V>& var
     return expression.differentiate(var);
 }
 
+
+// Bundle of the symbolic derivatives of an expression w.r.t. several variables. Since expressions
+// are structural types, sub-expressions shared by the components have the same type, and evaluating
+// the bundle computes each distinct node of all components exactly once.
+template<typename V, term... D>
+struct gradient_expression;
+
+template<typename... V, term... D>
+    requires(sizeof...(V) == sizeof...(D) and are_unique_v<V...>)
+struct gradient_expression<type_list<V...>, D...> {
+ private:
+    using nodes = typename detail::operand_nodes<type_list<>, D...>::type;
+
+    template<typename T>
+    static constexpr std::size_t node_index = [] <typename... N> (const type_list<N...>&) {
+        return detail::index_in<T, N...>;
+    } (nodes{});
+
+ public:
+    static constexpr std::size_t size = sizeof...(D);
+    static constexpr std::size_t node_count = type_list_size_v<nodes>;
+
+    constexpr gradient_expression() = default;
+    constexpr gradient_expression(const type_list<V...>&, const D&...) noexcept {}
+
+    // the derivative expression w.r.t. the given variable
+    template<typename T> requires(contains_decayed_v<T, V...>)
+    constexpr auto operator[](const T&) const noexcept {
+        return type_at_t<detail::index_in<std::remove_cvref_t<T>, V...>, D...>{};
+    }
+
+    template<typename R = automatic, typename... B>
+    constexpr auto evaluate(const bindings<B...>& b) const {
+        static_assert(((value_extent_v<V> == 1) and ...), "Gradient expressions only support scalar-valued variables");
+        using result_t = std::conditional_t<
+            std::is_same_v<R, automatic>, typename bindings<B...>::common_value_type, R
+        >;
+
+        std::array<result_t, node_count> values{};
+        [&] <typename... N> (const type_list<N...>&) {
+            (_evaluate_node(N{}, values, b), ...);  // post-order, i.e. operands come first
+        } (nodes{});
+
+        derivatives<result_t, V...> result;
+        ((result[V{}] = _value_of<D>(values, b)), ...);
+        return result;
+    }
+
+    template<typename W>
+    constexpr auto differentiate(const type_list<W>& var) const {
+        return gradient_expression<type_list<V...>, decltype(D{}.differentiate(var))...>{};
+    }
+
+    template<typename... B>
+    constexpr void export_to(std::ostream& out, const bindings<B...>& name_bindings) const {
+        out << "(";
+        [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            ((out << (i > 0 ? ", " : ""), D{}.export_to(out, name_bindings)), ...);
+        } (std::index_sequence_for<D...>{});
+        out << ")";
+    }
+
+ private:
+    template<typename op, typename... Ts, typename R, typename... B>
+    static constexpr void _evaluate_node(const expression<op, Ts...>&,
+                                         std::array<R, node_count>& values,
+                                         const bindings<B...>& b) {
+        values[node_index<expression<op, Ts...>>] = static_cast<R>(op{}(_value_of<Ts>(values, b)...));
+    }
+
+    template<typename T, typename R, typename... B>
+    static constexpr R _value_of(const std::array<R, node_count>& values, const bindings<B...>& b) {
+        if constexpr (is_any_of_v<T, nodes>)
+            return values[node_index<T>];
+        else
+            return static_cast<R>(T{}.evaluate(b));
+    }
+};
+
+template<typename... V, typename... D>
+gradient_expression(const type_list<V...>&, D&&...) -> gradient_expression<type_list<V...>, std::remove_cvref_t<D>...>;
+
+template<typename E, typename... V>
+    requires(sizeof...(V) > 1 and is_expression_v<std::remove_cvref_t<E>>)
+inline constexpr auto differentiate(const E& expression, const type_list<V...>& vars) {
+    return gradient_expression{vars, expression.differentiate(type_list<V>{})...};
+}
+
 }  // namespace adpp::backward
@@ -62,6 +62,17 @@ struct is_expression<function<E>> : std::true_type {};
 template<typename E>
 struct operands<function<E>> : operands<E> {};
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct unwrapped : std::type_identity<T> {};
+    template<typename E>
+    struct unwrapped<function<E>> : std::type_identity<E> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 template<typename E, typename... B>
     requires(expression_for<E, bindings<B...>>)
 inline constexpr auto evaluate(E&& e, const bindings<B...>& b) {
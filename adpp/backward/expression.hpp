@@ -1,7 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <tuple>
+#include <array>
+#include <cstddef>
 #include <utility>
+#include <algorithm>
 #include <type_traits>
 
 #include <adpp/type_traits.hpp>
@@ -14,36 +18,15 @@ namespace adpp::backward {
 #ifndef DOXYGEN
 namespace detail {
 
-    template<typename...>
-    struct symbols_impl;
+    // collects the symbols in the leaves of an expression, merging the (unique) symbols of the operands at each node
+    template<typename E>
+    struct symbols_impl : symbols_impl<operands_t<E>> {};
 
-    template<typename E, typename... Ts> requires(is_symbol_v<std::remove_cvref_t<E>>)
-    struct symbols_impl<E, type_list<Ts...>> {
-        using type = std::conditional_t<
-            symbolic<std::remove_cvref_t<E>>,
-            typename unique_types<type_list<Ts...>, std::remove_cvref_t<E>>::type,
-            typename unique_types<type_list<Ts...>>::type
-        >;
-    };
-
-    template<typename E, typename... Ts> requires(!is_symbol_v<std::remove_cvref_t<E>>)
-    struct symbols_impl<E, type_list<Ts...>> {
-        using type = typename symbols_impl<operands_t<E>, type_list<Ts...>>::type;
-    };
-
-    template<typename E0, typename... Es, typename... Ts>
-    struct symbols_impl<type_list<E0, Es...>, type_list<Ts...>> {
-        using type = typename unique_types<
-            typename merged_types<
-                typename symbols_impl<E0, type_list<Ts...>>::type,
-                typename symbols_impl<type_list<Es...>, type_list<Ts...>>::type
-            >::type
-        >::type;
-    };
+    template<typename E> requires(is_symbol_v<std::remove_cvref_t<E>>)
+    struct symbols_impl<E> : std::type_identity<type_list<std::remove_cvref_t<E>>> {};
 
-    // closures to stop recursion
-    template<typename... Ts> struct symbols_impl<type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
-    template<typename... Ts> struct symbols_impl<type_list<>, type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
+    template<typename... Ts>
+    struct symbols_impl<type_list<Ts...>> : merged_unique_types<typename symbols_impl<Ts>::type...> {};
 
     template<typename T> struct is_var : std::false_type {};
     template<typename T, auto _> struct is_var<var<T, _>> : std::true_type {};
@@ -52,7 +35,7 @@ namespace detail {
 #endif  // DOXYGEN
 
 template<typename E> requires(is_expression_v<std::remove_cvref_t<E>>)
-struct symbols : detail::symbols_impl<E, type_list<>> {};
+struct symbols : detail::symbols_impl<std::remove_cvref_t<E>> {};
 
 template<typename E> requires(is_expression_v<std::remove_cvref_t<E>>)
 using symbols_t = typename symbols<E>::type;
@@ -87,11 +70,68 @@ inline constexpr auto variables_of(const E&) {
 }
 
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename E>
+    struct vars_or_self : std::type_identity<std::conditional_t<is_var<E>::value, type_list<E>, type_list<>>> {};
+    template<typename E> requires(is_expression_v<E>)
+    struct vars_or_self<E> : vars<E> {};
+
+    template<typename L>
+    struct is_not_contained_in {
+        template<typename T>
+        struct type : std::bool_constant<!is_any_of_v<T, L>> {};
+    };
+
+    // the variables of the sub-expressions bound to (intermediate) symbols
+    template<typename L, typename... B>
+    struct intermediate_vars : std::type_identity<L> {};
+    template<typename L, typename B0, typename... B>
+    struct intermediate_vars<L, B0, B...> : intermediate_vars<std::conditional_t<
+        is_intermediate_binder<B0>::value,
+        merged_types_t<L, typename vars_or_self<typename std::remove_cvref_t<B0>::value_type>::type>,
+        L
+    >, B...> {};
+    template<typename L, typename... B>
+    struct intermediate_vars<L, bindings<B...>> : intermediate_vars<L, B...> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// the variables of a bound expression are those that are not bound in it
+template<typename E, typename B>
+inline constexpr auto variables_of(const bound_expression<E, B>&) {
+    using all_vars = unique_types_t<typename detail::intermediate_vars<
+        typename detail::vars_or_self<std::remove_cvref_t<E>>::type, std::remove_cvref_t<B>
+    >::type>;
+    using bound = typename std::remove_cvref_t<B>::bound_symbols;
+    return filtered_types_t<detail::is_not_contained_in<bound>::template type, all_vars>{};
+}
+
+
 // traits forward declarations
 template<typename R, typename op, typename... T> struct back_propagator;
 template<typename op, typename... T> struct formatter;
 template<typename op, typename... T> struct differentiator;
 
+// Customization point to evaluate and back-propagate sub-expressions of type E out of line, through one
+// non-inlined function per type (and bindings). All occurrences of a sub-expression share that function,
+// which trades a call for less code, if the optimizer does not already merge the inlined occurrences
+// (it does in benchmark/backwards/gradient.cpp, where outlining yields larger and slower code). For
+// instance, to outline large subtrees:
+//
+//     template<typename E> requires(adpp::backward::tree_size_v<E> >= 64)
+//     struct adpp::backward::outline<E> : std::true_type {};
+//
+// Specializations have to be visible wherever the expressions are evaluated.
+template<typename E>
+struct outline : std::false_type {};
+
+#ifndef DOXYGEN
+namespace detail { template<typename E> struct outlined; }
+#endif  // DOXYGEN
+
 template<typename op, term... Ts>
 struct expression : bindable, negatable {
     constexpr expression() = default;
@@ -99,12 +139,20 @@ struct expression : bindable, negatable {
 
     template<typename... B>
     constexpr decltype(auto) evaluate(const bindings<B...>& operands) const {
-        return op{}(Ts{}.evaluate(operands)...);
+        if constexpr (outline<expression>::value)
+            return detail::outlined<expression>::evaluate(operands);
+        else
+            return op{}(Ts{}.evaluate(operands)...);
     }
 
     template<scalar R, typename Self, typename... B, typename... V>
     constexpr auto back_propagate(this Self&& self, const bindings<B...>& bindings, const type_list<V...>& vars) {
-        auto [value, derivs] = back_propagator<R, op, Ts...>{}(bindings, vars);
+        auto [value, derivs] = [&] () {
+            if constexpr (outline<expression>::value)
+                return detail::outlined<expression>::template back_propagate<R>(bindings, vars);
+            else
+                return back_propagator<R, op, Ts...>{}(bindings, vars);
+        } ();
         if constexpr (contains_decayed_v<Self, V...>)
             derivs[self] = 1.0;
         return std::make_pair(std::move(value), std::move(derivs));
@@ -130,6 +178,228 @@ struct is_expression<expression<op, Ts...>> : std::true_type {};
 template<typename op, typename... T>
 struct operands<expression<op, T...>> : std::type_identity<type_list<T...>> {};
 
+
+// number of nodes in the tree of an expression, counting repeated sub-expressions once per occurrence
+template<typename E>
+struct tree_size : index_constant<1> {};
+template<typename op, typename... Ts>
+struct tree_size<expression<op, Ts...>> : index_constant<(std::size_t{1} + ... + tree_size<Ts>::value)> {};
+template<typename E>
+inline constexpr std::size_t tree_size_v = tree_size<std::remove_cvref_t<E>>::value;
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename op, typename... Ts>
+    struct outlined<expression<op, Ts...>> {
+        template<typename B>
+        [[gnu::noinline]] static constexpr auto evaluate(const B& b) {
+            return op{}(Ts{}.evaluate(b)...);
+        }
+
+        template<scalar R, typename B, typename... V>
+        [[gnu::noinline]] static constexpr auto back_propagate(const B& b, const type_list<V...>& vars) {
+            return back_propagator<R, op, Ts...>{}(b, vars);
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, typename L>
+    struct append_unique;
+    template<typename T, typename... Ts>
+    struct append_unique<T, type_list<Ts...>>
+    : std::type_identity<std::conditional_t<is_any_of_v<T, Ts...>, type_list<Ts...>, type_list<Ts..., T>>> {};
+
+    // collects all distinct expression nodes in post-order
+    template<typename T, typename L>
+    struct expression_nodes : std::type_identity<L> {};
+
+    template<typename L, typename... Ts>
+    struct operand_nodes : std::type_identity<L> {};
+    template<typename L, typename T, typename... Ts>
+    struct operand_nodes<L, T, Ts...> : operand_nodes<typename expression_nodes<T, L>::type, Ts...> {};
+
+    template<typename op, typename... Ts, typename L>
+    struct expression_nodes<expression<op, Ts...>, L>
+    : append_unique<expression<op, Ts...>, typename operand_nodes<L, Ts...>::type> {};
+
+    template<typename T, typename... Ts>
+    inline constexpr std::size_t index_in = index_of_type_v<T, Ts...>;
+
+    // replaces all occurrences of the symbol X by the expression I
+    template<typename T, typename X, typename I>
+    struct substituted : std::type_identity<std::conditional_t<std::is_same_v<T, X>, I, T>> {};
+
+    template<typename op, typename... Ts, typename X, typename I>
+    struct substituted<expression<op, Ts...>, X, I> {
+        using type = expression<op, typename substituted<Ts, X, I>::type...>;
+    };
+
+    // positions of the binders that are (or are not) intermediates
+    template<bool intermediate, typename... B>
+    inline constexpr auto binder_positions = [] () {
+        constexpr std::array<bool, sizeof...(B)> flags{is_intermediate_binder<B>::value...};
+        constexpr std::size_t count = (std::size_t{0} + ... + (is_intermediate_binder<B>::value == intermediate));
+        std::array<std::size_t, count> result{};
+        for (std::size_t i = 0, n = 0; i < flags.size(); ++i)
+            if (flags[i] == intermediate)
+                result[n++] = i;
+        return result;
+    } ();
+
+    template<typename... B>
+    inline constexpr auto intermediate_positions = binder_positions<true, B...>;
+
+    template<std::size_t i, typename... B>
+    inline constexpr std::size_t intermediate_rank = [] () {
+        constexpr std::array flags{is_intermediate_binder<B>::value...};
+        std::size_t n = 0;
+        for (std::size_t j = 0; j < i; ++j)
+            n += flags[j];
+        return n;
+    } ();
+
+    template<std::size_t k, typename... B>
+    using intermediate_symbol_t = typename std::remove_cvref_t<
+        type_at_t<intermediate_positions<B...>[k], B...>
+    >::symbol_type;
+
+    template<std::size_t k, typename... B>
+    using intermediate_expression_t = typename std::remove_cvref_t<
+        type_at_t<intermediate_positions<B...>[k], B...>
+    >::value_type;
+
+    template<typename L, typename S> struct mentions_any : std::false_type {};
+    template<typename... Ts, typename... S>
+    struct mentions_any<type_list<Ts...>, type_list<S...>> : std::bool_constant<(is_any_of_v<Ts, S...> or ...)> {};
+
+    template<typename... B, std::size_t... k>
+    inline constexpr bool has_nested_intermediates(const std::index_sequence<k...>&) {
+        using intermediate_symbols = type_list<intermediate_symbol_t<k, B...>...>;
+        return (mentions_any<typename symbols_impl<intermediate_expression_t<k, B...>>::type, intermediate_symbols>::value or ...);
+    }
+
+    // intermediates are resolved in a single pass and can thus not depend on other intermediates
+    template<typename... B>
+    inline constexpr bool are_independent_intermediates = !has_nested_intermediates<B...>(
+        std::make_index_sequence<intermediate_positions<B...>.size()>{}
+    );
+
+    // the expression in which all intermediate symbols are replaced by the sub-expressions bound to them
+    template<typename E, typename... P>
+    struct with_substitutions : std::type_identity<E> {};
+    template<typename E, typename S, typename I, typename... P>
+    struct with_substitutions<E, type_list<S, I>, P...>
+    : with_substitutions<typename substituted<E, S, I>::type, P...> {};
+
+    template<typename E, typename K, typename... B>
+    struct intermediates_substituted;
+    template<typename E, std::size_t... k, typename... B>
+    struct intermediates_substituted<E, std::index_sequence<k...>, B...>
+    : with_substitutions<E, type_list<intermediate_symbol_t<k, B...>, intermediate_expression_t<k, B...>>...> {};
+
+    template<typename E, typename... B>
+    using intermediates_substituted_t = typename intermediates_substituted<
+        E, std::make_index_sequence<intermediate_positions<B...>.size()>, B...
+    >::type;
+
+    template<typename... B>
+    inline constexpr auto without_intermediates(const bindings<B...>& b) {
+        constexpr auto positions = binder_positions<false, B...>;
+        return [&] <std::size_t... n> (const std::index_sequence<n...>&) {
+            return bindings<std::remove_cvref_t<type_at_t<positions[n], B...>>...>{
+                b.get(index_constant<positions[n]>{})...
+            };
+        } (std::make_index_sequence<positions.size()>{});
+    }
+
+    template<std::size_t i, typename... B, typename... T>
+    inline constexpr auto resolved_binder(const bindings<B...>& b, const std::tuple<T...>& values) {
+        using binder_t = std::remove_cvref_t<type_at_t<i, B...>>;
+        if constexpr (is_intermediate_binder<binder_t>::value) {
+            using symbol_t = typename binder_t::symbol_type;
+            using value_t = std::remove_cvref_t<type_at_t<intermediate_rank<i, B...>, T...>>;
+            return value_binder<symbol_t, value_t>{symbol_t{}, std::get<intermediate_rank<i, B...>>(values)};
+        } else {
+            return binder_t{b.get(index_constant<i>{})};
+        }
+    }
+
+    // replaces the intermediates by binders to their (precomputed) values
+    template<typename... B, typename... T, std::size_t... I>
+    inline constexpr auto with_intermediate_values(const bindings<B...>& b,
+                                                   const std::tuple<T...>& values,
+                                                   const std::index_sequence<I...>&) {
+        return bindings<decltype(resolved_binder<I>(b, values))...>{resolved_binder<I>(b, values)...};
+    }
+
+    template<typename... B>
+    struct intermediates {
+        static_assert(are_independent_intermediates<B...>, "Intermediates cannot be bound to expressions of other intermediates");
+
+        template<typename E>
+        static constexpr auto evaluate(const E& e, const bindings<B...>& b) {
+            return [&] <std::size_t... k> (const std::index_sequence<k...>&) {
+                const auto values = std::make_tuple(
+                    b.get(index_constant<intermediate_positions<B...>[k]>{}).unwrap().evaluate(b)...
+                );
+                return e.evaluate(with_intermediate_values(b, values, std::index_sequence_for<B...>{}));
+            } (std::make_index_sequence<intermediate_positions<B...>.size()>{});
+        }
+
+        template<scalar R, typename E, typename... V>
+        static constexpr auto back_propagate(const E& e, const bindings<B...>& b, const type_list<V...>& vars) {
+            return [&] <std::size_t... k> (const std::index_sequence<k...>&) {
+                static_assert(!(is_any_of_v<intermediate_symbol_t<k, B...>, V...> or ...), "Cannot differentiate w.r.t. intermediates");
+                static_assert(((value_extent_v<intermediate_symbol_t<k, B...>> == 1) and ...), "Intermediates must be scalar-valued");
+
+                // value & derivatives of each intermediate w.r.t. the requested variables
+                const auto resolved = std::make_tuple(
+                    b.get(index_constant<intermediate_positions<B...>[k]>{}).unwrap().template back_propagate<R>(b, vars)...
+                );
+                auto [value, derivs] = e.template back_propagate<R>(
+                    with_intermediate_values(b, std::make_tuple(std::get<k>(resolved).first...), std::index_sequence_for<B...>{}),
+                    type_list<V..., intermediate_symbol_t<k, B...>...>{}
+                );
+
+                // chain the adjoints of the intermediates into their inputs
+                derivatives<R, V...> result;
+                std::copy_n(derivs.as_array().begin(), result.flat_size, result.as_array().begin());
+                const auto chain = [&] (const R adjoint, const auto& intermediate_derivs) {
+                    const auto& in = intermediate_derivs.as_array();
+                    auto& out = result.as_array();
+                    for (std::size_t n = 0; n < out.size(); ++n)
+                        out[n] += adjoint*in[n];
+                };
+                (chain(derivs[intermediate_symbol_t<k, B...>{}], std::get<k>(resolved).second), ...);
+                return std::make_pair(std::move(value), std::move(result));
+            } (std::make_index_sequence<intermediate_positions<B...>.size()>{});
+        }
+
+        // substitutes the intermediates, such that their derivatives are chained symbolically
+        template<typename E, typename V>
+        static constexpr auto differentiate(const E&, const bindings<B...>& b, const type_list<V>& var) {
+            static_assert(
+                !std::disjunction_v<std::conjunction<
+                    std::is_same<V, typename std::remove_cvref_t<B>::symbol_type>, is_intermediate_binder<B>
+                >...>,
+                "Cannot differentiate w.r.t. intermediates"
+            );
+            using fused = intermediates_substituted_t<std::remove_cvref_t<E>, B...>;
+            return bound_expression{fused{}.differentiate(var), without_intermediates(b)};
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 }  // namespace adpp::backward
 
 // TODO: register (e.g.) std::exp for terms?
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include <adpp/dtype.hpp>
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/derivatives.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // placeholder symbols for the operands of a node, used to compute its local partial derivatives
+    template<std::size_t i>
+    struct operand_slot : symbol<dtype::any> {};
+
+    template<typename T, typename... V>
+    inline constexpr std::uint64_t dependency_mask = [] () {
+        if constexpr (is_any_of_v<T, V...>)
+            return std::uint64_t{1} << index_in<T, V...>;
+        else if constexpr (is_expression_v<T>)
+            return [] <typename... S> (const type_list<S...>&) {
+                return (std::uint64_t{0} | ... | dependency_mask<S, V...>);
+            } (symbols_t<T>{});
+        else
+            return std::uint64_t{0};
+    } ();
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<std::size_t i> struct is_symbol<detail::operand_slot<i>> : public std::true_type {};
+template<std::size_t i> struct is_unbound_symbol<detail::operand_slot<i>> : public std::true_type {};
+
+
+// Evaluator that caches the values and derivatives of all nodes of an expression between sweeps,
+// and only recomputes those that depend on symbols whose values changed since the last sweep.
+// Each node caches its derivatives w.r.t. all symbols, that is, memory and full sweeps scale with
+// O(nodes*symbols), and the symbols a node depends on are tracked in a 64-bit mask.
+template<term E, scalar R, typename... V>
+    requires(are_unique_v<V...>)
+class incremental_evaluator {
+    static_assert(((value_extent_v<V> == 1) and ...), "Incremental evaluation only supports scalar-valued symbols");
+    static_assert(sizeof...(V) <= 64, "Incremental evaluation supports at most 64 symbols (see dependency_mask)");
+
+    using root = typename detail::unwrapped<std::remove_cvref_t<E>>::type;
+    using nodes = typename detail::expression_nodes<root, type_list<>>::type;
+    using derivatives_t = derivatives<R, V...>;
+
+    static constexpr std::size_t num_nodes = type_list_size_v<nodes>;
+    static constexpr auto dependencies = [] <typename... N> (const type_list<N...>&) {
+        return std::array<std::uint64_t, sizeof...(N)>{detail::dependency_mask<N, V...>...};
+    } (nodes{});
+    static constexpr auto unit_derivatives = [] () {
+        std::array<derivatives_t, sizeof...(V)> result{};
+        for (std::size_t i = 0; i < sizeof...(V); ++i)
+            result[i].as_array()[i] = R{1};
+        return result;
+    } ();
+    static constexpr derivatives_t zero_derivatives{};
+
+    template<typename T>
+    static constexpr std::size_t node_index = [] <typename... N> (const type_list<N...>&) {
+        return detail::index_in<T, N...>;
+    } (nodes{});
+
+ public:
+    using value_type = R;
+
+    template<typename... B>
+    constexpr incremental_evaluator(const E&, const bindings<B...>& values)
+    : _inputs{static_cast<R>(values[V{}])...}
+    {
+        _stale_values.fill(true);
+        _stale_derivatives.fill(true);
+    }
+
+    // update the values of the given symbols, marking all nodes that depend on changed values as stale
+    template<typename... B>
+        requires(detail::are_binders<B...>)
+    constexpr void set(B&&... binders) {
+        (_set(std::forward<B>(binders)), ...);
+    }
+
+    template<typename... B>
+    constexpr void set(const bindings<B...>& values) {
+        (_set_value<typename std::remove_cvref_t<B>::symbol_type>(values[typename std::remove_cvref_t<B>::symbol_type{}]), ...);
+    }
+
+    constexpr R evaluate() {
+        _evaluations = 0;
+        return _value<root>();
+    }
+
+    constexpr const derivatives_t& grad() {
+        _evaluations = 0;
+        return _derivatives<root>();
+    }
+
+    constexpr auto value_and_grad() {
+        const auto& derivs = grad();
+        return std::make_pair(_value<root>(), derivs);
+    }
+
+    // number of nodes that had to be recomputed in the last sweep
+    constexpr std::size_t evaluations() const noexcept {
+        return _evaluations;
+    }
+
+    static constexpr std::size_t size() noexcept {
+        return num_nodes;
+    }
+
+ private:
+    template<typename B>
+    constexpr void _set(B&& binder) {
+        using symbol_type = typename std::remove_cvref_t<B>::symbol_type;
+        _set_value<symbol_type>(std::forward<B>(binder).unwrap());
+    }
+
+    template<typename S, typename T>
+    constexpr void _set_value(const T& value) {
+        static_assert(is_any_of_v<S, V...>, "Symbol is not an input of this evaluator");
+        constexpr std::size_t input_index = detail::index_in<S, V...>;
+        const R new_value = static_cast<R>(value);
+        if (new_value == _inputs[input_index])
+            return;
+
+        _inputs[input_index] = new_value;
+        constexpr std::uint64_t mask = std::uint64_t{1} << input_index;
+        for (std::size_t i = 0; i < num_nodes; ++i)
+            if (dependencies[i] & mask) {
+                _stale_values[i] = true;
+                _stale_derivatives[i] = true;
+            }
+    }
+
+    template<typename T>
+    constexpr R _value() {
+        if constexpr (is_any_of_v<T, V...>)
+            return _inputs[detail::index_in<T, V...>];
+        else if constexpr (is_any_of_v<T, nodes>)
+            return _node_value(T{});
+        else
+            return static_cast<R>(T{}.evaluate(bindings<>{}));
+    }
+
+    template<typename op, typename... Ts>
+    constexpr R _node_value(const expression<op, Ts...>&) {
+        constexpr std::size_t i = node_index<expression<op, Ts...>>;
+        if (_stale_values[i]) {
+            _values[i] = static_cast<R>(op{}(_value<Ts>()...));
+            _stale_values[i] = false;
+            ++_evaluations;
+        }
+        return _values[i];
+    }
+
+    template<typename T>
+    constexpr const derivatives_t& _derivatives() {
+        if constexpr (is_any_of_v<T, V...>)
+            return unit_derivatives[detail::index_in<T, V...>];
+        else if constexpr (is_any_of_v<T, nodes>)
+            return _node_derivatives(T{});
+        else
+            return zero_derivatives;
+    }
+
+    template<typename op, typename... Ts>
+    constexpr const derivatives_t& _node_derivatives(const expression<op, Ts...>& e) {
+        return _node_derivatives(e, std::index_sequence_for<Ts...>{});
+    }
+
+    template<typename op, typename... Ts, std::size_t... k>
+    constexpr const derivatives_t& _node_derivatives(const expression<op, Ts...>&, const std::index_sequence<k...>&) {
+        constexpr std::size_t i = node_index<expression<op, Ts...>>;
+        if (_stale_derivatives[i]) {
+            const std::array<const derivatives_t*, sizeof...(Ts)> operand_derivatives{&_derivatives<Ts>()...};
+            const auto operand_values = bindings{value_binder<detail::operand_slot<k>, R>{
+                detail::operand_slot<k>{}, _value<Ts>()
+            }...};
+            auto [value, partials] = expression<op, detail::operand_slot<k>...>{}.template back_propagate<R>(
+                operand_values, type_list<detail::operand_slot<k>...>{}
+            );
+
+            auto& result = _derivs[i].as_array();
+            result.fill(R{0});
+            for (std::size_t j = 0; j < sizeof...(Ts); ++j) {
+                const R partial = partials.as_array()[j];
+                const auto& operand = operand_derivatives[j]->as_array();
+                for (std::size_t n = 0; n < result.size(); ++n)
+                    result[n] += partial*operand[n];
+            }
+
+            if (_stale_values[i]) {
+                _values[i] = static_cast<R>(value);
+                _stale_values[i] = false;
+            }
+            _stale_derivatives[i] = false;
+            ++_evaluations;
+        }
+        return _derivs[i];
+    }
+
+    std::array<R, sizeof...(V)> _inputs;
+    std::array<R, num_nodes> _values{};
+    std::array<derivatives_t, num_nodes> _derivs{};
+    std::array<bool, num_nodes> _stale_values;
+    std::array<bool, num_nodes> _stale_derivatives;
+    std::size_t _evaluations = 0;
+};
+
+template<typename E, typename... B>
+incremental_evaluator(const E&, const bindings<B...>&) -> incremental_evaluator<
+    std::remove_cvref_t<E>,
+    typename bindings<B...>::common_value_type,
+    typename std::remove_cvref_t<B>::symbol_type...
+>;
+
+}  // namespace adpp::backward
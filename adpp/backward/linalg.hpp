@@ -0,0 +1,331 @@
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <ostream>
+#include <type_traits>
+
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/derivatives.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/operators.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline constexpr std::size_t block_size = 4;
+
+    template<typename T>
+    inline constexpr std::size_t static_size_v = std::tuple_size_v<std::remove_cvref_t<T>>;
+
+    template<typename A>
+    using element_t = std::remove_cvref_t<decltype(std::declval<const A&>()[0])>;
+
+    template<typename A, typename B>
+    using dot_result_t = std::common_type_t<element_t<A>, element_t<B>>;
+
+    // Accumulates into independent partial sums per block such that the compiler can vectorize the loop
+    template<typename A, typename B>
+    constexpr auto dot_kernel(const A& a, const B& b) noexcept {
+        using T = dot_result_t<A, B>;
+        constexpr std::size_t n = static_size_v<A>;
+        static_assert(n == static_size_v<B>, "Operands of dot products must have the same size");
+
+        std::array<T, block_size> partial_sums{};
+        std::size_t i = 0;
+        for (; i + block_size <= n; i += block_size)
+            for (std::size_t k = 0; k < block_size; ++k)
+                partial_sums[k] += a[i+k]*b[i+k];
+
+        T result = [&] <std::size_t... k> (const std::index_sequence<k...>&) {
+            return (partial_sums[k] + ...);
+        } (std::make_index_sequence<block_size>{});
+        for (; i < n; ++i)
+            result += a[i]*b[i];
+        return result;
+    }
+
+    template<typename M, typename X>
+    constexpr auto matvec_kernel(const M& m, const X& x) noexcept {
+        std::array<dot_result_t<element_t<M>, X>, static_size_v<M>> result;
+        for (std::size_t i = 0; i < static_size_v<M>; ++i)
+            result[i] = dot_kernel(m[i], x);
+        return result;
+    }
+
+    template<typename M, typename X>
+    constexpr auto transposed_matvec_kernel(const M& m, const X& x) noexcept {
+        constexpr std::size_t rows = static_size_v<M>;
+        constexpr std::size_t cols = static_size_v<element_t<M>>;
+        static_assert(rows == static_size_v<X>, "Matrix and vector sizes do not match");
+
+        std::array<dot_result_t<element_t<M>, X>, cols> result{};
+        for (std::size_t i = 0; i < rows; ++i)
+            for (std::size_t j = 0; j < cols; ++j)
+                result[j] += m[i][j]*x[i];
+        return result;
+    }
+
+    template<typename R, typename A, typename B>
+    constexpr auto outer_product_kernel(const A& a, const B& b) noexcept {
+        std::array<R, static_size_v<A>*static_size_v<B>> result;
+        for (std::size_t i = 0; i < static_size_v<A>; ++i)
+            for (std::size_t j = 0; j < static_size_v<B>; ++j)
+                result[i*static_size_v<B> + j] = a[i]*b[j];
+        return result;
+    }
+
+    // a/norm, or the subgradient zero at a = 0, where the norm is not differentiable
+    template<typename R, typename A, typename S>
+    constexpr auto normalized_copy(const A& a, S norm) noexcept {
+        std::array<R, static_size_v<A>> result{};
+        if (norm != S{0})
+            for (std::size_t i = 0; i < static_size_v<A>; ++i)
+                result[i] = a[i]/norm;
+        return result;
+    }
+
+    template<typename R, typename A, typename B>
+    constexpr auto sum_of(const A& a, const B& b) noexcept {
+        std::array<R, static_size_v<A>> result;
+        for (std::size_t i = 0; i < static_size_v<A>; ++i)
+            result[i] = a[i] + b[i];
+        return result;
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+
+namespace op {
+
+struct dot {
+    template<typename A, typename B>
+    constexpr auto operator()(const A& a, const B& b) const {
+        return detail::dot_kernel(a, b);
+    }
+};
+
+struct matvec {
+    template<typename M, typename X>
+    constexpr auto operator()(const M& m, const X& x) const {
+        return detail::matvec_kernel(m, x);
+    }
+};
+
+struct norm2 {
+    template<typename X>
+    constexpr auto operator()(const X& x) const {
+        using std::sqrt;
+        return sqrt(detail::dot_kernel(x, x));
+    }
+};
+
+struct quad {
+    template<typename X, typename M>
+    constexpr auto operator()(const X& x, const M& m) const {
+        return detail::dot_kernel(x, detail::matvec_kernel(m, x));
+    }
+};
+
+}  // namespace op
+
+
+template<term A, term B>
+inline constexpr op_result_t<op::dot, A, B> dot(A&& a, B&& b) {
+    return expression{op::dot{}, std::forward<A>(a), std::forward<B>(b)};
+}
+template<term M, term X>
+inline constexpr op_result_t<op::matvec, M, X> matvec(M&& m, X&& x) {
+    return expression{op::matvec{}, std::forward<M>(m), std::forward<X>(x)};
+}
+template<term X>
+inline constexpr op_result_t<op::norm2, X> norm2(X&& x) {
+    return expression{op::norm2{}, std::forward<X>(x)};
+}
+template<term X, term M>
+inline constexpr op_result_t<op::quad, X, M> quad(X&& x, M&& m) {
+    return expression{op::quad{}, std::forward<X>(x), std::forward<M>(m)};
+}
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, typename... V>
+    struct depends_on : std::bool_constant<contains_decayed_v<T, V...>> {};
+    template<typename op, typename... Ts, typename... V>
+    struct depends_on<expression<op, Ts...>, V...>
+    : std::disjunction<is_any_of<expression<op, Ts...>, V...>, depends_on<Ts, V...>...> {};
+
+    // Reverse sweep through array-valued terms: accumulates the adjoint `seed` (flattened row-major
+    // for matrices) of the value of `T` into the derivatives w.r.t. the array-valued symbols.
+    template<typename T, typename... B, typename R, typename... V, typename S>
+        requires(is_symbol_v<T>)
+    constexpr void propagate_adjoint(const T&, const bindings<B...>&, derivatives<R, V...>& derivs, const S& seed) {
+        if constexpr (contains_decayed_v<T, V...>) {
+            static_assert(
+                value_extent_v<T> == static_size_v<S>,
+                "Array-valued symbols must be declared with a shaped dtype (e.g. var<dtype::vector<N>>)"
+            );
+            if constexpr (value_extent_v<T> == 1) {
+                derivs[T{}] += seed[0];
+            } else {
+                auto adjoint = derivs[T{}];
+                for (std::size_t i = 0; i < static_size_v<S>; ++i)
+                    adjoint[i] += seed[i];
+            }
+        }
+    }
+
+    template<typename M, typename X, typename... B, typename R, typename... V, typename S>
+    constexpr void propagate_adjoint(const expression<op::matvec, M, X>&,
+                                     const bindings<B...>& b,
+                                     derivatives<R, V...>& derivs,
+                                     const S& seed) {
+        if constexpr (depends_on<M, V...>::value)
+            propagate_adjoint(M{}, b, derivs, outer_product_kernel<R>(seed, X{}.evaluate(b)));
+        if constexpr (depends_on<X, V...>::value)
+            propagate_adjoint(X{}, b, derivs, transposed_matvec_kernel(M{}.evaluate(b), seed));
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+
+// traits implementations
+template<typename R, typename A, typename B>
+struct back_propagator<R, op::dot, A, B> {
+    template<typename... _B, typename... V>
+    constexpr auto operator()(const bindings<_B...>& b, const type_list<V...>&) {
+        const auto& value_a = A{}.evaluate(b);
+        const auto& value_b = B{}.evaluate(b);
+        derivatives<R, V...> derivs{};
+        detail::propagate_adjoint(A{}, b, derivs, value_b);
+        detail::propagate_adjoint(B{}, b, derivs, value_a);
+        return std::make_pair(op::dot{}(value_a, value_b), std::move(derivs));
+    }
+};
+
+template<typename R, typename X>
+struct back_propagator<R, op::norm2, X> {
+    template<typename... _B, typename... V>
+    constexpr auto operator()(const bindings<_B...>& b, const type_list<V...>&) {
+        const auto& value_x = X{}.evaluate(b);
+        const auto result = op::norm2{}(value_x);
+        derivatives<R, V...> derivs{};
+        detail::propagate_adjoint(X{}, b, derivs, detail::normalized_copy<R>(value_x, result));
+        return std::make_pair(result, std::move(derivs));
+    }
+};
+
+template<typename R, typename X, typename M>
+struct back_propagator<R, op::quad, X, M> {
+    template<typename... _B, typename... V>
+    constexpr auto operator()(const bindings<_B...>& b, const type_list<V...>&) {
+        const auto& value_x = X{}.evaluate(b);
+        const auto& value_m = M{}.evaluate(b);
+        const auto m_x = detail::matvec_kernel(value_m, value_x);
+        derivatives<R, V...> derivs{};
+        if constexpr (detail::depends_on<X, V...>::value)
+            detail::propagate_adjoint(X{}, b, derivs, detail::sum_of<R>(
+                m_x, detail::transposed_matvec_kernel(value_m, value_x)
+            ));
+        if constexpr (detail::depends_on<M, V...>::value)
+            detail::propagate_adjoint(M{}, b, derivs, detail::outer_product_kernel<R>(value_x, value_x));
+        return std::make_pair(detail::dot_kernel(value_x, m_x), std::move(derivs));
+    }
+};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename V, typename... Ts>
+    constexpr auto linalg_derivative() {
+        if constexpr (!std::disjunction_v<depends_on<Ts, V>...>)
+            return cval<0>;
+        else
+            static_assert(
+                always_false<V>::value,
+                "Symbolic derivatives of linear-algebra expressions w.r.t. their operands are not supported, "
+                "use back-propagation (e.g. grad) instead."
+            );
+    }
+
+    template<typename... Ts, typename... N>
+    inline constexpr void as_call(std::ostream& out, const char* name, const bindings<N...>& name_map) {
+        out << name << "(";
+        std::size_t i = 0;
+        ((out << (i++ > 0 ? ", " : ""), Ts{}.export_to(out, name_map)), ...);
+        out << ")";
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename A, typename B>
+struct differentiator<op::dot, A, B> {
+    template<typename V>
+    constexpr auto operator()(const type_list<V>&) { return detail::linalg_derivative<V, A, B>(); }
+};
+
+template<typename M, typename X>
+struct differentiator<op::matvec, M, X> {
+    template<typename V>
+    constexpr auto operator()(const type_list<V>&) { return detail::linalg_derivative<V, M, X>(); }
+};
+
+template<typename X>
+struct differentiator<op::norm2, X> {
+    template<typename V>
+    constexpr auto operator()(const type_list<V>&) { return detail::linalg_derivative<V, X>(); }
+};
+
+template<typename X, typename M>
+struct differentiator<op::quad, X, M> {
+    template<typename V>
+    constexpr auto operator()(const type_list<V>&) { return detail::linalg_derivative<V, X, M>(); }
+};
+
+
+template<typename A, typename B>
+struct formatter<op::dot, A, B> {
+    template<typename... N>
+    constexpr void operator()(std::ostream& out, const bindings<N...>& name_map) {
+        detail::as_call<A, B>(out, "dot", name_map);
+    }
+};
+
+template<typename M, typename X>
+struct formatter<op::matvec, M, X> {
+    template<typename... N>
+    constexpr void operator()(std::ostream& out, const bindings<N...>& name_map) {
+        detail::as_call<M, X>(out, "matvec", name_map);
+    }
+};
+
+template<typename X>
+struct formatter<op::norm2, X> {
+    template<typename... N>
+    constexpr void operator()(std::ostream& out, const bindings<N...>& name_map) {
+        detail::as_call<X>(out, "norm2", name_map);
+    }
+};
+
+template<typename X, typename M>
+struct formatter<op::quad, X, M> {
+    template<typename... N>
+    constexpr void operator()(std::ostream& out, const bindings<N...>& name_map) {
+        detail::as_call<X, M>(out, "quad", name_map);
+    }
+};
+
+}  // namespace adpp::backward
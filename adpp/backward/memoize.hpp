@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/derivatives.hpp>
+#include <adpp/backward/expression.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename R, typename V>
+    struct derivatives_for;
+    template<typename R, typename... V>
+    struct derivatives_for<R, type_list<V...>> : std::type_identity<derivatives<R, V...>> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// Wraps a function (or expression) and caches its values and gradients, keyed on the values bound
+// to its symbols. The cache has a fixed capacity and uses open addressing with bounded linear probing,
+// evicting entries on collisions. It is split into independently locked shards, such that a single
+// instance can be shared between threads.
+template<term E, scalar R = double>
+    requires(is_expression_v<E>)
+class memoized {
+    using keys = unbound_symbols_t<E>;
+    using vars = vars_t<E>;
+    using key_type = std::array<R, type_list_size_v<keys>>;
+
+ public:
+    using value_type = R;
+    using derivatives_type = typename detail::derivatives_for<R, vars>::type;
+
+    static constexpr std::size_t num_shards = 16;
+    static constexpr std::size_t max_probes = 4;
+
+    template<typename _E> requires(std::constructible_from<E, _E>)
+    explicit memoized(_E&& e, std::size_t capacity = 1024)
+    : _e{std::forward<_E>(e)}
+    , _shard_capacity{std::max<std::size_t>(capacity/num_shards, 1)}
+    , _shards{std::make_unique<shard[]>(num_shards)} {
+        for (std::size_t i = 0; i < num_shards; ++i)
+            _shards[i].entries = std::make_unique<entry[]>(_shard_capacity);
+    }
+
+    template<typename... B>
+    R operator()(const bindings<B...>& values) const {
+        return evaluate(values);
+    }
+
+    template<typename... B>
+        requires(sizeof...(B) != 1 or !is_binding_v<std::remove_cvref_t<B>...>)
+    R operator()(B&&... values) const {
+        return evaluate(at(std::forward<B>(values)...));
+    }
+
+    template<typename... B>
+    R evaluate(const bindings<B...>& values) const {
+        return _lookup<false>(values).first;
+    }
+
+    template<typename... B>
+    std::pair<R, derivatives_type> value_and_grad(const bindings<B...>& values) const {
+        return _lookup<true>(values);
+    }
+
+    std::size_t hits() const noexcept { return _hits.load(std::memory_order_relaxed); }
+    std::size_t misses() const noexcept { return _misses.load(std::memory_order_relaxed); }
+    double hit_rate() const noexcept {
+        const std::size_t total = hits() + misses();
+        return total > 0 ? static_cast<double>(hits())/static_cast<double>(total) : 0.0;
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < num_shards; ++i) {
+            std::lock_guard lock{_shards[i].mutex};
+            std::fill_n(_shards[i].entries.get(), _shard_capacity, entry{});
+        }
+        _hits.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+    }
+
+ private:
+    struct entry {
+        key_type key{};
+        R value{};
+        derivatives_type derivatives{};
+        bool occupied = false;
+        bool has_derivatives = false;
+    };
+
+    struct shard {
+        std::mutex mutex;
+        std::unique_ptr<entry[]> entries;
+    };
+
+    template<typename B>
+    static key_type _key(const B& values) {
+        return [&] <typename... K> (const type_list<K...>&) {
+            return key_type{static_cast<R>(values[K{}])...};
+        } (keys{});
+    }
+
+    static std::size_t _hash(const key_type& key) noexcept {
+        std::size_t result = 0;
+        for (const auto& v : key)
+            result ^= std::hash<R>{}(v) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+        return result;
+    }
+
+    template<bool with_derivatives, typename B>
+    std::pair<R, derivatives_type> _lookup(const B& values) const {
+        const key_type key = _key(values);
+        const std::size_t hash = _hash(key);
+        shard& s = _shards[hash%num_shards];
+        const std::size_t home = (hash/num_shards)%_shard_capacity;
+
+        {
+            std::lock_guard lock{s.mutex};
+            for (std::size_t probe = 0; probe < std::min(max_probes, _shard_capacity); ++probe) {
+                const entry& e = s.entries[(home + probe)%_shard_capacity];
+                if (e.occupied && e.key == key && (!with_derivatives || e.has_derivatives)) {
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return {e.value, e.derivatives};
+                }
+            }
+        }
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        entry computed{.key = key, .occupied = true, .has_derivatives = with_derivatives};
+        if constexpr (with_derivatives) {
+            auto [value, derivs] = _e.template back_propagate<R>(values, vars{});
+            computed.value = static_cast<R>(value);
+            computed.derivatives = std::move(derivs);
+        } else {
+            computed.value = static_cast<R>(_e.evaluate(values));
+        }
+
+        {
+            std::lock_guard lock{s.mutex};
+            std::size_t slot = home;
+            for (std::size_t probe = 0; probe < std::min(max_probes, _shard_capacity); ++probe) {
+                const std::size_t candidate = (home + probe)%_shard_capacity;
+                if (!s.entries[candidate].occupied || s.entries[candidate].key == key) {
+                    slot = candidate;
+                    break;
+                }
+            }
+            s.entries[slot] = computed;
+        }
+        return {computed.value, computed.derivatives};
+    }
+
+    E _e;
+    std::size_t _shard_capacity;
+    std::unique_ptr<shard[]> _shards;
+    mutable std::atomic<std::size_t> _hits{0};
+    mutable std::atomic<std::size_t> _misses{0};
+};
+
+template<typename E>
+memoized(E&&) -> memoized<std::remove_cvref_t<E>>;
+
+template<typename E>
+memoized(E&&, std::size_t) -> memoized<std::remove_cvref_t<E>>;
+
+}  // namespace adpp::backward
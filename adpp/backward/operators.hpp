@@ -41,6 +41,7 @@ namespace detail {
     template<typename... Ts>
     inline constexpr bool all_cvals_v = std::conjunction_v<is_cval<std::remove_cvref_t<Ts>>...>;
 
+    // scalars become values with their own type and storage, for literals known at compile time use `_c`
     template<into_term T, auto _ = [] () {}>
     inline constexpr decltype(auto) as_term(T&& t) noexcept {
         if constexpr (term<std::remove_cvref_t<T>>)
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <span>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <initializer_list>
+
+#include <adpp/concepts.hpp>
+#include <adpp/backward/tape.hpp>
+#include <adpp/backward/bytecode.hpp>
+
+namespace adpp::backward {
+
+// Parser for expressions in the infix format written by `export_to`, e.g. `exp((x + y/x)*µ)`, which
+// produces bytecode that can be evaluated and differentiated at runtime. Each of the symbol names
+// given on construction is mapped to the input slot at the same position. The text is tokenized in
+// a single pass without allocations per token, and the buffers are reused between calls to `parse`.
+template<scalar R = double>
+class expression_parser {
+ public:
+    using value_type = R;
+    using index_type = std::uint32_t;
+
+    static constexpr std::size_t max_depth = 256;
+
+    explicit expression_parser(std::initializer_list<std::string_view> symbols)
+    : expression_parser(std::span<const std::string_view>{symbols.begin(), symbols.size()})
+    {}
+
+    explicit expression_parser(std::span<const std::string_view> symbols)
+    : _names(symbols.begin(), symbols.end()) {
+        for (std::size_t i = 0; i < _names.size(); ++i) {
+            if (!_is_name(_names[i]))
+                throw std::invalid_argument("Invalid symbol name");
+            if (!_slots.emplace(_names[i], static_cast<index_type>(i)).second)
+                throw std::invalid_argument("Symbol names must be unique");
+        }
+        _input_registers.resize(_names.size());
+    }
+
+    // symbol names may not be changed, since the slot map refers to them
+    expression_parser(const expression_parser&) = delete;
+    expression_parser& operator=(const expression_parser&) = delete;
+
+    constexpr std::size_t num_inputs() const noexcept { return _names.size(); }
+    constexpr std::span<const std::string> symbols() const noexcept { return _names; }
+
+    bytecode<R> parse(std::string_view text) {
+        _reset(text);
+        _parse_sum();
+        _skip_whitespace();
+        if (_pos != _text.size())
+            throw std::invalid_argument("Unexpected character in expression");
+        return bytecode<R>{_instructions, _constants, static_cast<index_type>(_names.size())};
+    }
+
+    // parses one expression per non-empty line, e.g. from a model file
+    std::vector<bytecode<R>> parse_lines(std::string_view text) {
+        std::vector<bytecode<R>> result;
+        while (!text.empty()) {
+            const std::size_t end = std::min(text.find('\n'), text.size());
+            const std::string_view line = text.substr(0, end);
+            if (line.find_first_not_of(" \t\r") != std::string_view::npos)
+                result.push_back(parse(line));
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+        return result;
+    }
+
+ private:
+    static constexpr index_type unused = std::numeric_limits<index_type>::max();
+
+    static constexpr bool _is_name_start(char c) noexcept {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    static constexpr bool _is_name_char(char c) noexcept {
+        return _is_name_start(c) || (c >= '0' && c <= '9');
+    }
+
+    static constexpr bool _is_name(std::string_view name) noexcept {
+        if (name.empty() || !_is_name_start(name.front()))
+            return false;
+        for (char c : name)
+            if (!_is_name_char(c))
+                return false;
+        return true;
+    }
+
+    void _reset(std::string_view text) {
+        _text = text;
+        _pos = 0;
+        _depth = 0;
+        _instructions.clear();
+        _constants.clear();
+        std::ranges::fill(_input_registers, unused);
+    }
+
+    void _skip_whitespace() noexcept {
+        while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\r' || _text[_pos] == '\n'))
+            ++_pos;
+    }
+
+    bool _consume(char c) noexcept {
+        _skip_whitespace();
+        if (_pos < _text.size() && _text[_pos] == c) {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    index_type _emit(opcode code, index_type lhs, index_type rhs) {
+        _instructions.push_back({code, lhs, rhs});
+        return static_cast<index_type>(_instructions.size() - 1);
+    }
+
+    index_type _emit_constant(R value) {
+        _constants.push_back(value);
+        return _emit(opcode::constant, static_cast<index_type>(_constants.size() - 1), 0);
+    }
+
+    index_type _parse_sum() {
+        index_type result = _parse_product();
+        while (true) {
+            if (_consume('+'))
+                result = _emit(opcode::add, result, _parse_product());
+            else if (_consume('-'))
+                result = _emit(opcode::subtract, result, _parse_product());
+            else
+                return result;
+        }
+    }
+
+    index_type _parse_product() {
+        index_type result = _parse_unary();
+        while (true) {
+            if (_consume('*'))
+                result = _emit(opcode::multiply, result, _parse_unary());
+            else if (_consume('/'))
+                result = _emit(opcode::divide, result, _parse_unary());
+            else
+                return result;
+        }
+    }
+
+    index_type _parse_unary() {
+        // leading signs are counted instead of recursing per sign, and only their parity matters
+        std::size_t signs = 0;
+        while (_consume('-'))
+            if (++signs > max_depth)
+                throw std::invalid_argument("Expression is nested too deeply");
+
+        const index_type operand = _parse_primary();
+        if (signs % 2 == 0)
+            return operand;
+
+        // negated literals are folded into the constant, other operands are multiplied by -1 (see `negatable`)
+        if (_instructions[operand].code == opcode::constant && operand + 1 == _instructions.size()) {
+            _constants[_instructions[operand].lhs] = -_constants[_instructions[operand].lhs];
+            return operand;
+        }
+        return _emit(opcode::multiply, _emit_constant(R{-1}), operand);
+    }
+
+    index_type _parse_primary() {
+        _skip_whitespace();
+        if (_pos == _text.size())
+            throw std::invalid_argument("Unexpected end of expression");
+
+        const char c = _text[_pos];
+        if (c == '(')
+            return _parse_braces();
+        if ((c >= '0' && c <= '9') || c == '.')
+            return _parse_number();
+        if (_is_name_start(c))
+            return _parse_name();
+        throw std::invalid_argument("Unexpected character in expression");
+    }
+
+    index_type _parse_braces() {
+        if (++_depth > max_depth)
+            throw std::invalid_argument("Expression is nested too deeply");
+        _consume('(');
+        const index_type result = _parse_sum();
+        if (!_consume(')'))
+            throw std::invalid_argument("Missing closing brace in expression");
+        --_depth;
+        return result;
+    }
+
+    index_type _parse_number() {
+        double value;
+        const auto [end, error] = std::from_chars(_text.data() + _pos, _text.data() + _text.size(), value);
+        if (error != std::errc{})
+            throw std::invalid_argument("Invalid number in expression");
+        _pos = static_cast<std::size_t>(end - _text.data());
+        return _emit_constant(static_cast<R>(value));
+    }
+
+    index_type _parse_name() {
+        const std::size_t begin = _pos;
+        while (_pos < _text.size() && _is_name_char(_text[_pos]))
+            ++_pos;
+        const std::string_view name = _text.substr(begin, _pos - begin);
+
+        _skip_whitespace();
+        if (_pos < _text.size() && _text[_pos] == '(') {
+            if (name != "exp")
+                throw std::invalid_argument("Unknown function in expression");
+            const index_type operand = _parse_braces();
+            return _emit(opcode::exp, operand, operand);
+        }
+
+        const auto it = _slots.find(name);
+        if (it == _slots.end())
+            throw std::invalid_argument("Unknown symbol in expression");
+        index_type& input = _input_registers[it->second];
+        if (input == unused)
+            input = _emit(opcode::input, it->second, 0);
+        return input;
+    }
+
+    std::vector<std::string> _names;
+    std::unordered_map<std::string_view, index_type> _slots;
+    std::vector<index_type> _input_registers;
+    std::vector<instruction> _instructions;
+    std::vector<R> _constants;
+    std::string_view _text;
+    std::size_t _pos = 0;
+    std::size_t _depth = 0;
+};
+
+#ifdef ADPP_EXTERN_TEMPLATES
+// instantiated in the object file of the adpp module (see ADPP_BUILD_MODULE)
+extern template class expression_parser<double>;
+#endif
+
+}  // namespace adpp::backward
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ostream>
+#include <type_traits>
+
+#include <adpp/dtype.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+
+namespace adpp::backward {
+
+// Symbol that stands in for a sub-expression whose value has been precomputed.
+template<typename E>
+struct precomputed : symbol<dtype::any> {
+    using expression_type = E;
+
+    template<typename... B>
+    constexpr void export_to(std::ostream& out, const bindings<B...>& name_bindings) const {
+        E{}.export_to(out, name_bindings);
+    }
+};
+
+template<typename E> struct is_symbol<precomputed<E>> : public std::true_type {};
+template<typename E> struct is_unbound_symbol<precomputed<E>> : public std::true_type {};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T> struct is_precomputed : std::false_type {};
+    template<typename E> struct is_precomputed<precomputed<E>> : std::true_type {};
+
+    template<typename L, typename S>
+    struct all_contained;
+    template<typename... Ts, typename S>
+    struct all_contained<type_list<Ts...>, S> : std::conjunction<is_any_of<Ts, S>...> {};
+
+    // replaces all sub-expressions whose symbols are all contained in S by precomputed nodes
+    template<typename T, typename S>
+    struct specialized : std::type_identity<T> {};
+
+    template<typename E, typename S>
+    struct specialized<function<E>, S> : specialized<E, S> {};
+
+    template<typename op, typename... Ts, typename S>
+    struct specialized<expression<op, Ts...>, S> {
+        using type = std::conditional_t<
+            all_contained<unbound_symbols_t<expression<op, Ts...>>, S>::value,
+            precomputed<expression<op, Ts...>>,
+            expression<op, typename specialized<Ts, S>::type...>
+        >;
+    };
+
+    template<typename T>
+    struct precomputed_nodes : std::type_identity<std::conditional_t<is_precomputed<T>::value, type_list<T>, type_list<>>> {};
+    template<typename T> requires(is_expression_v<T>)
+    struct precomputed_nodes<T> : filtered_types<is_precomputed, symbols_t<T>> {};
+
+    template<typename P, typename B>
+    using precomputed_value_t = std::remove_cvref_t<decltype(typename P::expression_type{}.evaluate(std::declval<const B&>()))>;
+
+    template<typename... B, typename... P>
+    inline constexpr auto with_precomputed_values(const bindings<B...>& b, const type_list<P...>&) {
+        using bindings_t = bindings<B...>;
+        return concatenated(b, bindings<value_binder<P, precomputed_value_t<P, bindings_t>>...>{
+            value_binder<P, precomputed_value_t<P, bindings_t>>{P{}, typename P::expression_type{}.evaluate(b)}...
+        });
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// Precomputes all sub-expressions that only depend on the given bindings. The result is a
+// bound expression that evaluates/differentiates the remainder on the remaining symbols.
+// Note that the bound symbols are treated as constants, that is, their derivatives vanish.
+template<typename E, typename... B> requires(is_expression_v<std::remove_cvref_t<E>>)
+inline constexpr auto specialize(const E&, const bindings<B...>& b) {
+    using specialized = typename detail::specialized<
+        std::remove_cvref_t<E>, typename bindings<B...>::bound_symbols
+    >::type;
+    return bound_expression{
+        specialized{},
+        detail::with_precomputed_values(b, typename detail::precomputed_nodes<specialized>::type{})
+    };
+}
+
+}  // namespace adpp::backward
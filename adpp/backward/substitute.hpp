@@ -0,0 +1,74 @@
+#pragma once
+
+#include <type_traits>
+
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+
+namespace adpp::backward {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    struct bound_expression_access {
+        template<typename E, typename B>
+        static constexpr decltype(auto) expression_of(const bound_expression<E, B>& e) noexcept {
+            return e._expression.get();
+        }
+
+        template<typename E, typename B>
+        static constexpr decltype(auto) bindings_of(const bound_expression<E, B>& e) noexcept {
+            return e._bindings.get();
+        }
+    };
+
+    template<typename T> struct is_bound_expression : std::false_type {};
+    template<typename E, typename B> struct is_bound_expression<bound_expression<E, B>> : std::true_type {};
+
+    template<typename T> struct is_function : std::false_type {};
+    template<typename E> struct is_function<function<E>> : std::true_type {};
+
+    // the expression type underlying functions and bound expressions
+    template<typename T>
+    struct unbound : unwrapped<T> {};
+    template<typename E, typename B>
+    struct unbound<bound_expression<E, B>> : unwrapped<std::remove_cvref_t<E>> {};
+
+    template<typename T>
+    concept substitutable = term<T> or is_bound_expression<T>::value;
+
+    template<typename T>
+    inline constexpr auto bindings_of(const T& t) {
+        if constexpr (is_bound_expression<T>::value)
+            return bound_expression_access::bindings_of(t);
+        else
+            return bindings<>{};
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// Composes two expressions by substituting the symbol x in the outer expression by the inner one.
+// The result is a single (fused) expression type, such that evaluation and differentiation see the
+// entire composition. Bindings of bound (outer or inner) expressions are carried over to the result.
+template<typename O, typename X, typename I>
+    requires(detail::substitutable<O> and detail::substitutable<I> and is_unbound_symbol_v<std::remove_cvref_t<X>>)
+inline constexpr auto substitute(const O& outer, const X&, const I& inner) {
+    using fused = typename detail::substituted<
+        typename detail::unbound<O>::type,
+        std::remove_cvref_t<X>,
+        typename detail::unbound<I>::type
+    >::type;
+
+    if constexpr (detail::is_bound_expression<O>::value or detail::is_bound_expression<I>::value)
+        return bound_expression{fused{}, concatenated(detail::bindings_of(outer), detail::bindings_of(inner))};
+    else if constexpr (detail::is_function<O>::value)
+        return function{fused{}};
+    else
+        return fused{};
+}
+
+}  // namespace adpp::backward
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <limits>
+#include <cstdint>
+#include <cstddef>
 #include <ostream>
 #include <utility>
+#include <string_view>
 #include <type_traits>
 
 #include <adpp/dtype.hpp>
@@ -56,6 +60,106 @@ template<auto value>
 inline constexpr constant<value> cval;
 
 
+#ifndef DOXYGEN
+namespace detail {
+
+    // decimal literal split into its significand and (base 10) exponent
+    struct decimal_literal {
+        std::uint64_t significand = 0;
+        int exponent = 0;
+        bool is_integral = true;
+        bool is_valid = true;
+    };
+
+    inline constexpr bool accumulate_digit(std::uint64_t& value, char c) noexcept {
+        const auto digit = static_cast<std::uint64_t>(c - '0');
+        if (c < '0' || c > '9' || value > (std::numeric_limits<std::uint64_t>::max() - digit)/10)
+            return false;
+        value = 10*value + digit;
+        return true;
+    }
+
+    template<char... cs>
+    inline constexpr decimal_literal parse_decimal_literal() noexcept {
+        constexpr char chars[]{cs...};
+        constexpr std::size_t size = sizeof...(cs);
+        decimal_literal result;
+
+        // octal and binary integers are not supported (hexadecimal digits are rejected below)
+        if (size > 1 && chars[0] == '0' && std::string_view{chars, size}.find_first_of(".eE") == std::string_view::npos) {
+            result.is_valid = false;
+            return result;
+        }
+
+        std::size_t i = 0;
+        bool is_fraction = false;
+        for (; i < size && chars[i] != 'e' && chars[i] != 'E'; ++i) {
+            if (chars[i] == '\'')
+                continue;
+            if (chars[i] == '.') {
+                is_fraction = true;
+                result.is_integral = false;
+            } else if (accumulate_digit(result.significand, chars[i])) {
+                result.exponent -= is_fraction;
+            } else {
+                result.is_valid = false;
+                return result;
+            }
+        }
+
+        if (i < size) {
+            result.is_integral = false;
+            const bool is_negative = ++i < size && chars[i] == '-';
+            i += (i < size && (chars[i] == '-' || chars[i] == '+'));
+            std::uint64_t exponent = 0;
+            for (; i < size; ++i)
+                if (chars[i] != '\'' && (!accumulate_digit(exponent, chars[i]) || exponent > 1000))
+                    result.is_valid = false;
+            result.exponent += is_negative ? -static_cast<int>(exponent) : static_cast<int>(exponent);
+        }
+        return result;
+    }
+
+    template<char... cs>
+    inline constexpr auto literal_value() noexcept {
+        constexpr decimal_literal literal = parse_decimal_literal<cs...>();
+        static_assert(literal.is_valid, "Only decimal literals are supported as compile-time constants");
+        if constexpr (literal.is_integral) {
+            static_assert(literal.significand <= std::numeric_limits<long long>::max(), "Integer literal is too large");
+            if constexpr (literal.significand <= std::numeric_limits<int>::max())
+                return static_cast<int>(literal.significand);
+            else
+                return static_cast<long long>(literal.significand);
+        } else {
+            // significands and powers of ten that are exactly representable yield correctly rounded values
+            static_assert(
+                literal.significand <= (std::uint64_t{1} << 53) && literal.exponent >= -22 && literal.exponent <= 22,
+                "Floating-point literal cannot be converted exactly at compile time, use cval instead"
+            );
+            double power = 1.0;
+            for (int n = 0; n < (literal.exponent < 0 ? -literal.exponent : literal.exponent); ++n)
+                power *= 10.0;
+            const auto significand = static_cast<double>(literal.significand);
+            return literal.exponent < 0 ? significand/power : significand*power;
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+namespace literals {
+
+// Literals whose values are encoded in their type, e.g. `2_c*x` or `0.5_c*x`. Equal literals yield the same
+// `constant`, which share a node in expression trees and can be folded, while scalars passed to the operators
+// become a new type per literal (see `val`) with its own storage and instantiations.
+template<char... cs>
+inline constexpr auto operator""_c() noexcept {
+    return constant<detail::literal_value<cs...>()>{};
+}
+
+}  // namespace literals
+
+
 struct negatable {
     template<typename Self>
     constexpr auto operator-(this Self&& self) {
@@ -234,5 +338,7 @@ template<typename T, auto _> struct is_symbol<var<T, _>> : public std::true_type
 template<typename T, auto _> struct is_symbol<let<T, _>> : public std::true_type {};
 template<typename T, auto _> struct is_unbound_symbol<var<T, _>> : public std::true_type {};
 template<typename T, auto _> struct is_unbound_symbol<let<T, _>> : public std::true_type {};
+template<typename T, auto _> struct value_extent<var<T, _>> : public dtype::extent<T> {};
+template<typename T, auto _> struct value_extent<let<T, _>> : public dtype::extent<T> {};
 
 }  // namespace adpp::backward
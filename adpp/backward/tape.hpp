@@ -0,0 +1,434 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <span>
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include <adpp/concepts.hpp>
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/expression.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/operators.hpp>
+
+namespace adpp::backward {
+
+enum class opcode : std::uint8_t {
+    input,
+    constant,
+    add,
+    subtract,
+    multiply,
+    divide,
+    exp,
+    preaccumulated
+};
+
+// Entry on a tape. The operands refer to previously recorded entries, except for inputs, for which
+// the first operand is the position of the input in the list of inputs, and preaccumulated entries,
+// for which it refers to the static expression (and its operands) recorded on the tape.
+struct instruction {
+    opcode code;
+    std::uint32_t lhs;
+    std::uint32_t rhs;
+};
+
+static_assert(std::is_trivially_copyable_v<instruction> and std::is_standard_layout_v<instruction>);
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename R>
+    inline constexpr R apply(opcode code, R a, R b) {
+        switch (code) {
+            case opcode::add: return op::add{}(a, b);
+            case opcode::subtract: return op::subtract{}(a, b);
+            case opcode::multiply: return op::multiply{}(a, b);
+            case opcode::divide: return op::divide{}(a, b);
+            case opcode::exp: return op::exp{}(a);
+            default: throw std::invalid_argument("Opcode is not an operator");
+        }
+    }
+
+    // adds the contributions of the adjoint of an operator entry (with the given operand and result values)
+    // to the adjoints of its operands, which may refer to the same entry
+    template<typename R>
+    inline constexpr void propagate_adjoint(opcode code, R adjoint, R a, R b, R result, R& adjoint_a, R& adjoint_b) {
+        switch (code) {
+            case opcode::add:
+                adjoint_a += adjoint;
+                adjoint_b += adjoint;
+                break;
+            case opcode::subtract:
+                adjoint_a += adjoint;
+                adjoint_b -= adjoint;
+                break;
+            case opcode::multiply:
+                adjoint_a += adjoint*b;
+                adjoint_b += adjoint*a;
+                break;
+            case opcode::divide:
+                adjoint_a += adjoint/b;
+                adjoint_b -= adjoint*a/(b*b);
+                break;
+            case opcode::exp:
+                adjoint_a += adjoint*result;
+                break;
+            default: throw std::invalid_argument("Opcode is not an operator");
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+// With hash-consing, structurally identical entries (same operator, operands and constant value)
+// are recorded only once, such that common sub-expressions are shared automatically.
+enum class deduplication : bool {
+    off,
+    on
+};
+
+struct tape_statistics {
+    std::size_t recorded = 0;  // number of entries requested during recording
+    std::size_t unique = 0;    // number of entries actually stored on the tape
+
+    constexpr double deduplication_ratio() const noexcept {
+        return unique > 0 ? static_cast<double>(recorded)/static_cast<double>(unique) : 1.0;
+    }
+};
+
+
+// Runtime expression graph, recorded as a contiguous sequence of instructions. A tape can be replayed
+// with new input values to compute values and gradients, using the same operators as static expressions.
+template<scalar R = double>
+class tape {
+ public:
+    using value_type = R;
+    using index_type = std::uint32_t;
+
+    // handle to an entry on a tape, which records new entries when used in arithmetic operations
+    class node {
+     public:
+        constexpr node(tape& t, index_type index) noexcept
+        : _tape{&t}
+        , _index{index}
+        {}
+
+        constexpr index_type index() const noexcept { return _index; }
+        constexpr R value() const noexcept { return _tape->value(*this); }
+
+        friend constexpr node operator+(const node& a, const node& b) { return a._tape->record(opcode::add, a, b); }
+        friend constexpr node operator-(const node& a, const node& b) { return a._tape->record(opcode::subtract, a, b); }
+        friend constexpr node operator*(const node& a, const node& b) { return a._tape->record(opcode::multiply, a, b); }
+        friend constexpr node operator/(const node& a, const node& b) { return a._tape->record(opcode::divide, a, b); }
+
+        friend constexpr node operator+(const node& a, R b) { return a + a._tape->constant(b); }
+        friend constexpr node operator-(const node& a, R b) { return a - a._tape->constant(b); }
+        friend constexpr node operator*(const node& a, R b) { return a * a._tape->constant(b); }
+        friend constexpr node operator/(const node& a, R b) { return a / a._tape->constant(b); }
+
+        friend constexpr node operator+(R a, const node& b) { return b._tape->constant(a) + b; }
+        friend constexpr node operator-(R a, const node& b) { return b._tape->constant(a) - b; }
+        friend constexpr node operator*(R a, const node& b) { return b._tape->constant(a) * b; }
+        friend constexpr node operator/(R a, const node& b) { return b._tape->constant(a) / b; }
+
+        friend constexpr node operator-(const node& a) { return R{-1}*a; }
+        friend constexpr node exp(const node& a) { return a._tape->record(opcode::exp, a, a); }
+
+     private:
+        friend class tape;
+
+        tape* _tape;
+        index_type _index;
+    };
+
+    constexpr explicit tape(std::size_t capacity = 1024, deduplication mode = deduplication::off)
+    : _deduplicate{mode == deduplication::on} {
+        _instructions.reserve(capacity);
+        _values.reserve(capacity);
+        if (_deduplicate)
+            _slots.resize(std::bit_ceil(std::max<std::size_t>(2*capacity, 16)));
+    }
+
+    // nodes refer to their tape by address, so a tape can be neither copied nor moved
+    tape(const tape&) = delete;
+    tape& operator=(const tape&) = delete;
+
+    constexpr node input(R value) {
+        ++_recorded;
+        return _push({opcode::input, _num_inputs++, 0}, value);
+    }
+
+    constexpr node constant(R value) {
+        return _record({opcode::constant, 0, 0}, value);
+    }
+
+    constexpr node record(opcode code, const node& a, const node& b) {
+        if (a._tape != this || b._tape != this)
+            throw std::invalid_argument("Nodes have been recorded on a different tape");
+
+        // canonical operand order for commutative operators increases the number of shared entries
+        const bool commutative = code == opcode::add || code == opcode::multiply;
+        const index_type lhs = commutative ? std::min(a.index(), b.index()) : a.index();
+        const index_type rhs = commutative ? std::max(a.index(), b.index()) : b.index();
+        return _record({code, lhs, rhs}, detail::apply(code, _values[lhs], _values[rhs]));
+    }
+
+    // Records a static expression as a single entry, whose operands are the nodes (or values) bound to
+    // its symbols. Its value and local gradient are computed with the expression's own reverse sweep.
+    template<typename E, typename... B>
+        requires(is_expression_v<std::remove_cvref_t<E>> and sizeof...(B) > 0)
+    constexpr node record(const E&, const bindings<B...>& b) {
+        using expression_t = typename detail::unwrapped<std::remove_cvref_t<E>>::type;
+        static_assert(
+            [] <typename... S> (const type_list<S...>&) {
+                return bindings<B...>::template contains_bindings_for<S...>;
+            } (unbound_symbols_t<expression_t>{}),
+            "All symbols of the expression must be bound to nodes or values"
+        );
+
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            const std::array<index_type, sizeof...(B)> operands{_operand(b.get(index_constant<i>{}).unwrap())...};
+            _preaccumulations.push_back({
+                .offset = static_cast<index_type>(_operands.size()),
+                .size = static_cast<index_type>(sizeof...(B)),
+                .kernel = &_preaccumulated_kernel<expression_t, typename std::remove_cvref_t<B>::symbol_type...>
+            });
+            _operands.insert(_operands.end(), operands.begin(), operands.end());
+            _partials.resize(_operands.size());
+
+            ++_recorded;
+            const instruction instr{opcode::preaccumulated, static_cast<index_type>(_preaccumulations.size() - 1), 0};
+            return _push(instr, _evaluate_preaccumulated(instr));
+        } (std::index_sequence_for<B...>{});
+    }
+
+    // clears the tape in constant time, keeping the allocated memory for the next recording
+    constexpr void reset() noexcept {
+        _instructions.clear();
+        _values.clear();
+        _operands.clear();
+        _partials.clear();
+        _preaccumulations.clear();
+        _num_inputs = 0;
+        _recorded = 0;
+        if (++_generation == 0) {
+            std::ranges::fill(_slots, slot{});
+            _generation = 1;
+        }
+    }
+
+    constexpr tape_statistics statistics() const noexcept {
+        return {.recorded = _recorded, .unique = _instructions.size()};
+    }
+
+    constexpr std::size_t size() const noexcept { return _instructions.size(); }
+    constexpr std::size_t num_inputs() const noexcept { return _num_inputs; }
+    constexpr std::span<const instruction> instructions() const noexcept { return _instructions; }
+    constexpr R value(const node& n) const noexcept { return _values[n.index()]; }
+
+    // replays the tape with new input values, and returns the value of the given node
+    constexpr R evaluate(std::span<const R> inputs, const node& output) {
+        if (inputs.size() != _num_inputs)
+            throw std::invalid_argument("Number of input values does not match the number of recorded inputs");
+        for (std::size_t i = 0; i <= output.index(); ++i) {
+            const instruction& instr = _instructions[i];
+            switch (instr.code) {
+                case opcode::input: _values[i] = inputs[instr.lhs]; break;
+                case opcode::constant: break;
+                case opcode::preaccumulated: _values[i] = _evaluate_preaccumulated(instr); break;
+                default: _values[i] = detail::apply(instr.code, _values[instr.lhs], _values[instr.rhs]);
+            }
+        }
+        return _values[output.index()];
+    }
+
+    // reverse sweep over the tape using the current values, writing d(output)/d(input) into the given buffer
+    constexpr void gradient(const node& output, std::span<R> gradient) {
+        if (gradient.size() < _num_inputs)
+            throw std::invalid_argument("Gradient buffer is too small");
+
+        _adjoints.assign(output.index() + 1, R{0});
+        std::fill_n(gradient.begin(), _num_inputs, R{0});
+        _adjoints[output.index()] = R{1};
+        for (std::size_t i = output.index() + 1; i-- > 0;) {
+            // zero adjoints are propagated as well, such that e.g. 0*inf yields NaN as on the template path
+            const R adjoint = _adjoints[i];
+            const instruction& instr = _instructions[i];
+            if (instr.code == opcode::preaccumulated) {
+                const auto& entry = _preaccumulations[instr.lhs];
+                for (std::size_t k = entry.offset; k < entry.offset + entry.size; ++k)
+                    _adjoints[_operands[k]] += adjoint*_partials[k];
+                continue;
+            }
+
+            switch (instr.code) {
+                case opcode::input: gradient[instr.lhs] += adjoint; break;
+                case opcode::constant: break;
+                default: detail::propagate_adjoint(
+                    instr.code, adjoint, _values[instr.lhs], _values[instr.rhs], _values[i],
+                    _adjoints[instr.lhs], _adjoints[instr.rhs]
+                );
+            }
+        }
+    }
+
+    constexpr R value_and_grad(std::span<const R> inputs, const node& output, std::span<R> gradient) {
+        const R result = evaluate(inputs, output);
+        this->gradient(output, gradient);
+        return result;
+    }
+
+ private:
+    // computes the value and writes the local gradient w.r.t. the operands of a preaccumulated entry
+    using kernel_t = R(*)(const R* values, const index_type* operands, R* partials);
+
+    struct preaccumulation {
+        index_type offset;
+        index_type size;
+        kernel_t kernel;
+    };
+
+    template<typename E, typename... S>
+    static constexpr R _preaccumulated_kernel(const R* values, const index_type* operands, R* partials) {
+        static_assert(((value_extent_v<S> == 1) and ...), "Preaccumulation only supports scalar-valued symbols");
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            const bindings<value_binder<S, R>...> b{value_binder<S, R>{S{}, values[operands[i]]}...};
+            auto [value, derivs] = E{}.template back_propagate<R>(b, type_list<S...>{});
+            std::ranges::copy(derivs.as_array(), partials);
+            return static_cast<R>(value);
+        } (std::index_sequence_for<S...>{});
+    }
+
+    constexpr R _evaluate_preaccumulated(const instruction& instr) {
+        const auto& entry = _preaccumulations[instr.lhs];
+        return entry.kernel(_values.data(), _operands.data() + entry.offset, _partials.data() + entry.offset);
+    }
+
+    constexpr index_type _operand(const node& n) const {
+        if (n._tape != this)
+            throw std::invalid_argument("Nodes have been recorded on a different tape");
+        return n.index();
+    }
+
+    template<scalar T>
+    constexpr index_type _operand(const T& value) {
+        return constant(static_cast<R>(value)).index();
+    }
+
+    // slots of the hash table used for deduplication, which are invalidated by bumping the generation
+    struct slot {
+        index_type index = 0;
+        std::uint32_t generation = 0;
+    };
+
+    constexpr node _record(const instruction& instr, R value) {
+        ++_recorded;
+        if (!_deduplicate)
+            return _push(instr, value);
+
+        if (2*(_instructions.size() + 1) > _slots.size())
+            _rehash(2*_slots.size());
+
+        const std::size_t mask = _slots.size() - 1;
+        for (std::size_t i = _hash(instr, value) & mask; ; i = (i + 1) & mask) {
+            slot& s = _slots[i];
+            if (s.generation != _generation) {
+                const node result = _push(instr, value);
+                s = {result.index(), _generation};
+                return result;
+            }
+            if (_is_equal(_instructions[s.index], _values[s.index], instr, value))
+                return node{*this, s.index};
+        }
+    }
+
+    constexpr node _push(const instruction& instr, R value) {
+        _instructions.push_back(instr);
+        _values.push_back(value);
+        return node{*this, static_cast<index_type>(_instructions.size() - 1)};
+    }
+
+    constexpr void _rehash(std::size_t size) {
+        _slots.assign(size, slot{});
+        _generation = 1;
+        const std::size_t mask = _slots.size() - 1;
+        for (std::size_t n = 0; n < _instructions.size(); ++n) {
+            if (_instructions[n].code == opcode::input || _instructions[n].code == opcode::preaccumulated)
+                continue;
+            std::size_t i = _hash(_instructions[n], _values[n]) & mask;
+            while (_slots[i].generation == _generation)
+                i = (i + 1) & mask;
+            _slots[i] = {static_cast<index_type>(n), _generation};
+        }
+    }
+
+    static constexpr std::size_t _hash(const instruction& instr, R value) noexcept {
+        std::size_t h = static_cast<std::size_t>(instr.code);
+        h = h*0x9e3779b97f4a7c15ull + instr.lhs;
+        h = h*0x9e3779b97f4a7c15ull + instr.rhs;
+        if (instr.code == opcode::constant)
+            h ^= _constant_hash(value) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        return h ^ (h >> 29);
+    }
+
+    static constexpr bool _is_equal(const instruction& a, R value_a, const instruction& b, R value_b) noexcept {
+        return a.code == b.code
+            && a.lhs == b.lhs
+            && a.rhs == b.rhs
+            && (a.code != opcode::constant || _is_same_constant(value_a, value_b));
+    }
+
+    // Constants are keyed on their bit patterns, such that -0.0 is not merged into 0.0 (which would flip the
+    // sign of e.g. 1/(x*-0.0)) and equal NaNs are shared. Types without an unsigned integer of the same size
+    // (e.g. the 80-bit long double) compare the signs of zeros and the NaNs explicitly.
+    using _bits_type = std::conditional_t<
+        sizeof(R) == sizeof(std::uint32_t), std::uint32_t,
+        std::conditional_t<sizeof(R) == sizeof(std::uint64_t), std::uint64_t, void>
+    >;
+
+    static constexpr bool _is_same_constant(R a, R b) noexcept {
+        if constexpr (!std::is_void_v<_bits_type>)
+            return std::bit_cast<_bits_type>(a) == std::bit_cast<_bits_type>(b);
+        else
+            return (a == b && std::signbit(a) == std::signbit(b)) || (a != a && b != b);
+    }
+
+    static constexpr std::size_t _constant_hash(R value) noexcept {
+        if constexpr (!std::is_void_v<_bits_type>)
+            return std::hash<_bits_type>{}(std::bit_cast<_bits_type>(value));
+        else
+            return value != value ? 0 : std::hash<R>{}(value) ^ static_cast<std::size_t>(std::signbit(value));
+    }
+
+    std::vector<instruction> _instructions;
+    std::vector<R> _values;
+    std::vector<R> _adjoints;
+    std::vector<index_type> _operands;
+    std::vector<R> _partials;
+    std::vector<preaccumulation> _preaccumulations;
+    std::vector<slot> _slots;
+    index_type _num_inputs = 0;
+    std::size_t _recorded = 0;
+    std::uint32_t _generation = 1;
+    bool _deduplicate;
+};
+
+#ifdef ADPP_EXTERN_TEMPLATES
+// instantiated in the object file of the adpp module (see ADPP_BUILD_MODULE)
+extern template class tape<double>;
+#endif
+
+}  // namespace adpp::backward
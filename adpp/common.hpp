@@ -17,6 +17,12 @@ inline constexpr order<1> first_order;
 inline constexpr order<2> second_order;
 inline constexpr order<3> third_order;
 
+struct row_major {};
+struct column_major {};
+
+inline constexpr row_major row_major_layout;
+inline constexpr column_major column_major_layout;
+
 template<typename T>
 class storage {
     using stored = std::conditional_t<std::is_lvalue_reference_v<T>, T, std::remove_cvref_t<T>>;
@@ -56,31 +62,20 @@ constexpr bool is_same_object(A&& a, B&& b) {
 }
 
 
-#ifndef DOXYGEN
-namespace detail {
-
-    template<std::size_t I, typename T>
-    struct indexed_element {
-        using index = index_constant<I>;
-
-        template<same_remove_cvref_t_as<T> _T>
-        constexpr index index_of() const noexcept { return {}; }
-        constexpr index index_of(const T&) const noexcept { return {}; }
-    };
-
-    template<typename... Ts>
-    struct indexed;
-
-    template<std::size_t... I, typename... Ts>
-    struct indexed<std::index_sequence<I...>, Ts...> : indexed_element<I, Ts>... {
-        using indexed_element<I, Ts>::index_of...;
-    };
-
-}  // namespace detail
-#endif  // DOXYGEN
-
+// Maps the given (unique) types to their positions. Lookups do not depend on the number of types,
+// since the position is computed directly instead of resolving an overload set with one entry per type.
 template<typename... Ts> requires(are_unique_v<Ts...>)
-struct indexed : detail::indexed<std::make_index_sequence<sizeof...(Ts)>, Ts...> {};
+struct indexed {
+    template<typename T> requires(contains_decayed_v<T, Ts...>)
+    static constexpr auto index_of() noexcept {
+        return index_constant<index_of_type_v<std::remove_cvref_t<T>, std::remove_cvref_t<Ts>...>>{};
+    }
+
+    template<typename T> requires(contains_decayed_v<T, Ts...>)
+    static constexpr auto index_of(const T&) noexcept {
+        return index_of<T>();
+    }
+};
 
 
 #ifndef DOXYGEN
@@ -88,15 +83,9 @@ namespace detail {
 
     template<std::size_t I, typename T>
     struct variadic_element {
-        using index = index_constant<I>;
-
         constexpr variadic_element(T t) noexcept : _storage{std::forward<T>(t)} {}
 
-        template<same_remove_cvref_t_as<T> _T>
-        constexpr index index_of() const noexcept { return {}; }
-        constexpr index index_of(const T&) const noexcept { return {}; }
-
-        constexpr const std::remove_cvref_t<T>& get(const index&) const noexcept {
+        constexpr const std::remove_cvref_t<T>& get() const noexcept {
             return _storage.get();
         }
 
@@ -110,8 +99,11 @@ namespace detail {
     template<std::size_t... I, typename... Ts>
     struct variadic_accessor<std::index_sequence<I...>, Ts...> : variadic_element<I, Ts>... {
         constexpr variadic_accessor(Ts... ts) noexcept : variadic_element<I, Ts>(std::forward<Ts>(ts))... {}
-        using variadic_element<I, Ts>::index_of...;
-        using variadic_element<I, Ts>::get...;
+
+        template<std::size_t i>
+        constexpr const auto& get(const index_constant<i>&) const noexcept {
+            return static_cast<const variadic_element<i, type_at_t<i, Ts...>>&>(*this).get();
+        }
     };
 
 }  // namespace detail
@@ -119,7 +111,9 @@ namespace detail {
 
 template<typename... Ts>
     requires(are_unique_v<Ts...>)
-struct variadic_accessor : detail::variadic_accessor<std::make_index_sequence<sizeof...(Ts)>, Ts...> {
+struct variadic_accessor
+: indexed<Ts...>
+, detail::variadic_accessor<std::make_index_sequence<sizeof...(Ts)>, Ts...> {
  private:
     using base = detail::variadic_accessor<std::make_index_sequence<sizeof...(Ts)>, Ts...>;
 
@@ -128,6 +122,9 @@ struct variadic_accessor : detail::variadic_accessor<std::make_index_sequence<si
     : base(std::forward<Ts>(ts)...)
     {}
 
+    using indexed<Ts...>::index_of;
+    using base::get;
+
     template<typename T> requires(contains_decayed_v<T, Ts...>)
     constexpr auto index(const T& t) const noexcept {
         return this->get(this->index_of(t));
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <tuple>
+#include <cstddef>
 #include <type_traits>
 #include <adpp/concepts.hpp>
 
@@ -10,6 +12,38 @@ struct any {};
 struct real {};
 struct integral {};
 
+template<std::size_t N>
+struct vector {};
+
+template<std::size_t M, std::size_t N>
+struct matrix {};
+
+
+template<typename T>
+struct extent : public std::integral_constant<std::size_t, 1> {};
+template<std::size_t N>
+struct extent<vector<N>> : public std::integral_constant<std::size_t, N> {};
+template<std::size_t M, std::size_t N>
+struct extent<matrix<M, N>> : public std::integral_constant<std::size_t, M*N> {};
+template<typename T>
+inline constexpr std::size_t extent_v = extent<T>::value;
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, std::size_t N>
+    concept array_of_size = requires { std::tuple_size<std::remove_cvref_t<T>>::value; }
+        and std::tuple_size_v<std::remove_cvref_t<T>> == N
+        and requires(const std::remove_cvref_t<T>& t) { t[0]; };
+
+    template<typename T, std::size_t M, std::size_t N>
+    concept matrix_of_size = array_of_size<T, M>
+        and array_of_size<decltype(std::declval<const std::remove_cvref_t<T>&>()[0]), N>;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 template<typename T, typename Arg>
 struct accepts;
 
@@ -21,6 +55,10 @@ template<typename Arg>
 struct accepts<integral, Arg> : public std::bool_constant<std::is_integral_v<std::remove_cvref_t<Arg>>> {};
 template<scalar T, typename Arg>
 struct accepts<T, Arg> : public std::is_same<T, std::remove_cvref_t<Arg>> {};
+template<std::size_t N, typename Arg>
+struct accepts<vector<N>, Arg> : public std::bool_constant<detail::array_of_size<Arg, N>> {};
+template<std::size_t M, std::size_t N, typename Arg>
+struct accepts<matrix<M, N>, Arg> : public std::bool_constant<detail::matrix_of_size<Arg, M, N>> {};
 
 }  // namespace dtype
 
@@ -2,6 +2,7 @@
 
 #include <type_traits>
 #include <utility>
+#include <tuple>
 
 
 namespace adpp {
@@ -55,8 +56,79 @@ template<typename... T>
 using first_type_t = typename first_type<T...>::type;
 
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<std::size_t i, typename T>
+    struct indexed_type {};
+
+    // Map from positions to types (and vice versa), in which lookups are resolved by deducing
+    // the template arguments of a base class. This requires no recursive instantiations, and
+    // the deduction fails if a type is not contained or occurs more than once.
+    template<typename I, typename... Ts>
+    struct type_index_map;
+    template<std::size_t... i, typename... Ts>
+    struct type_index_map<std::index_sequence<i...>, Ts...> : indexed_type<i, Ts>... {};
+
+    template<typename... Ts>
+    using type_index_map_for = type_index_map<std::index_sequence_for<Ts...>, Ts...>;
+
+    template<std::size_t i, typename T>
+    std::type_identity<T> type_lookup(const indexed_type<i, T>&);
+    template<typename T, std::size_t i>
+    index_constant<i> index_lookup(const indexed_type<i, T>&);
+
+    template<typename T, typename M>
+    concept unambiguous_in = requires (const M& map) { index_lookup<T>(map); };
+
+    template<typename T, typename... Ts>
+    inline constexpr std::size_t first_index_of = [] () {
+        constexpr bool matches[sizeof...(Ts) + 1]{std::is_same_v<T, Ts>..., true};
+        std::size_t i = 0;
+        while (!matches[i])
+            ++i;
+        return i;
+    } ();
+
+    // Folds are avoided for packs of arbitrary length, since clang limits the number of their
+    // operands to the bracket depth (256 by default).
+    template<bool... values>
+    inline constexpr bool all_of = [] () {
+        constexpr bool flags[sizeof...(values) + 1]{values..., true};
+        for (const bool flag : flags)
+            if (!flag)
+                return false;
+        return true;
+    } ();
+
+}  // end namespace detail
+#endif  // DOXYGEN
+
+
+#if defined(__cpp_pack_indexing)
+template<std::size_t i, typename... Ts>
+struct type_at : std::type_identity<Ts...[i]> {};
+#else
+template<std::size_t i, typename... Ts>
+struct type_at : decltype(detail::type_lookup<i>(std::declval<detail::type_index_map_for<Ts...>>())) {};
+#endif
+template<std::size_t i, typename... Ts>
+struct type_at<i, type_list<Ts...>> : type_at<i, Ts...> {};
+template<std::size_t i, typename... Ts>
+using type_at_t = typename type_at<i, Ts...>::type;
+
+
+// position of the first occurrence of T in Ts (or the number of types if it is not contained)
+template<typename T, typename... Ts>
+struct index_of_type : index_constant<detail::first_index_of<T, Ts...>> {};
+template<typename T, typename... Ts>
+struct index_of_type<T, type_list<Ts...>> : index_of_type<T, Ts...> {};
 template<typename T, typename... Ts>
-struct is_any_of : std::bool_constant<std::disjunction_v<std::is_same<T, Ts>...>> {};
+inline constexpr std::size_t index_of_type_v = index_of_type<T, Ts...>::value;
+
+
+template<typename T, typename... Ts>
+struct is_any_of : std::bool_constant<(detail::first_index_of<T, Ts...> < sizeof...(Ts))> {};
 template<typename T, typename... Ts>
 struct is_any_of<T, type_list<Ts...>> : is_any_of<T, Ts...> {};
 template<typename T, typename... Ts>
@@ -71,23 +143,11 @@ template<typename T, typename... Ts>
 inline constexpr bool contains_decayed_v = contains_decayed<T, Ts...>::value;
 
 
-template<typename... T>
-struct are_unique;
-template<typename T1, typename T2, typename... Ts>
-struct are_unique<T1, T2, Ts...> {
-    static constexpr bool value =
-        are_unique<T1, T2>::value &&
-        are_unique<T1, Ts...>::value &&
-        are_unique<T2, Ts...>::value;
-};
-template<typename T1, typename T2>
-struct are_unique<T1, T2> : std::bool_constant<!std::is_same_v<T1, T2>> {};
-template<typename T>
-struct are_unique<T> : std::true_type {};
-template<>
-struct are_unique<> : std::true_type {};
-template<typename... T>
-struct are_unique<type_list<T...>> : are_unique<T...> {};
+template<typename... Ts>
+struct are_unique
+: std::bool_constant<detail::all_of<detail::unambiguous_in<Ts, detail::type_index_map_for<Ts...>>...>> {};
+template<typename... Ts>
+struct are_unique<type_list<Ts...>> : are_unique<Ts...> {};
 template<typename... Ts>
 inline constexpr bool are_unique_v = are_unique<Ts...>::value;
 
@@ -95,48 +155,108 @@ inline constexpr bool are_unique_v = are_unique<Ts...>::value;
 #ifndef DOXYGEN
 namespace detail {
 
-    template<typename T, typename... Ts>
-    struct unique_types {
-        using type = std::conditional_t<
-            is_any_of_v<T, Ts...>,
-            typename unique_types<Ts...>::type,
-            typename unique_types<type_list<T>, Ts...>::type
-        >;
+    template<std::size_t n>
+    struct selection {
+        std::size_t positions[n + 1]{};
+        std::size_t size = 0;
     };
 
+    template<bool... keep>
+    inline constexpr selection<sizeof...(keep)> selection_of = [] () {
+        constexpr bool flags[sizeof...(keep) + 1]{keep..., false};
+        selection<sizeof...(keep)> result;
+        for (std::size_t i = 0; i < sizeof...(keep); ++i)
+            if (flags[i])
+                result.positions[result.size++] = i;
+        return result;
+    } ();
+
+    template<typename L, auto s, typename I = std::make_index_sequence<s.size>>
+    struct selected_types_at;
+    template<typename... Ts, auto s, std::size_t... k>
+    struct selected_types_at<type_list<Ts...>, s, std::index_sequence<k...>>
+    : std::type_identity<type_list<type_at_t<s.positions[k], Ts...>...>> {};
+
+    // the types whose flag is set, in their order in the list
+    template<typename L, bool... keep>
+    struct selected_types : selected_types_at<L, selection_of<keep...>> {};
+
+    template<typename I, typename... Ts>
+    struct unique_types_impl;
+    template<std::size_t... i, typename... Ts>
+    struct unique_types_impl<std::index_sequence<i...>, Ts...>
+    : selected_types<type_list<Ts...>, (first_index_of<Ts, Ts...> == i)...> {};
+
+    // keeps the first occurrence of each type
+    template<typename... Ts>
+    struct unique_types : unique_types_impl<std::index_sequence_for<Ts...>, Ts...> {};
+
     template<typename T>
-    struct unique_types<T> : std::type_identity<type_list<T>> {};
-
-    template<typename... Ts, typename T, typename... Rest>
-    struct unique_types<type_list<Ts...>, T, Rest...> {
-        using type = std::conditional_t<
-            is_any_of_v<T, Ts...>,
-            typename unique_types<type_list<Ts...>, Rest...>::type,
-            typename unique_types<type_list<Ts..., T>, Rest...>::type
-        >;
+    struct type_tag {};
+
+    // Set of types that is merged with another set per step of a fold expression. Membership is tested
+    // via the base classes, such that neither recursive instantiations nor folds over the types are required.
+    template<typename... Ts>
+    struct type_set : type_tag<Ts>... {
+        using list = type_list<Ts...>;
+
+        template<typename... Us>
+        constexpr auto operator|(type_set<Us...>) const noexcept {
+            return _append(typename selected_types<type_list<Us...>, !std::is_base_of_v<type_tag<Us>, type_set>...>::type{});
+        }
+
+     private:
+        template<typename... Us>
+        static constexpr type_set<Ts..., Us...> _append(type_list<Us...>) noexcept {
+            return {};
+        }
     };
 
+    template<typename L>
+    struct as_type_set;
     template<typename... Ts>
-    struct unique_types<type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
+    struct as_type_set<type_list<Ts...>> : std::type_identity<type_set<Ts...>> {};
+
+    // Union of lists without repetitions, keeping the first occurrence of each type. The folds only
+    // run over the lists and the types of each list, such that merging small lists repeatedly (e.g.
+    // at each node of an expression) never processes the concatenation of all of them.
+    template<typename... Ls>
+    struct merged_unique_types
+    : std::type_identity<typename decltype((type_set<>{} | ... | typename as_type_set<Ls>::type{}))::list> {};
 
-    template<typename A, typename B>
-    struct merged_types;
+    template<typename... Ts>
+    struct concatenation {
+        using list = type_list<Ts...>;
 
-    template<typename... As, typename... Bs>
-    struct merged_types<type_list<As...>, type_list<Bs...>> {
-        using type = type_list<As..., Bs...>;
+        template<typename... Us>
+        constexpr concatenation<Ts..., Us...> operator+(concatenation<Us...>) const noexcept {
+            return {};
+        }
     };
 
+    template<typename L>
+    struct as_concatenation;
+    template<typename... Ts>
+    struct as_concatenation<type_list<Ts...>> : std::type_identity<concatenation<Ts...>> {};
+
+    template<typename... Ls>
+    struct merged_types
+    : std::type_identity<typename decltype((concatenation<>{} + ... + typename as_concatenation<Ls>::type{}))::list> {};
+
+    template<template<typename> typename filter, typename... Ts>
+    struct filtered_types : selected_types<type_list<Ts...>, filter<Ts>::value...> {};
+
 }  // namespace detail
 #endif  // DOXYGEN
 
 
 template<typename T, typename... Ts>
 struct unique_types : detail::unique_types<T, Ts...> {};
-template<typename... Ts> requires(sizeof...(Ts) > 0)
+template<typename... Ts>
 struct unique_types<type_list<Ts...>> : detail::unique_types<Ts...> {};
-template<>
-struct unique_types<type_list<>> : std::type_identity<type_list<>> {};
+// a leading list is an accumulator, to which the unique ones of the remaining types are appended
+template<typename... Ts, typename T, typename... Rest>
+struct unique_types<type_list<Ts...>, T, Rest...> : detail::unique_types<Ts..., T, Rest...> {};
 template<typename A, typename... Ts>
 using unique_types_t = typename unique_types<A, Ts...>::type;
 
@@ -145,32 +265,16 @@ struct merged_types : detail::merged_types<A, Ts...> {};
 template<typename A, typename... Ts>
 using merged_types_t = typename merged_types<A, Ts...>::type;
 
-
-#ifndef DOXYGEN
-namespace detail {
-
-    template<template<typename> typename filter, typename...>
-    struct filtered_types_impl;
-    template<template<typename> typename filter, typename T, typename... rest, typename... current>
-    struct filtered_types_impl<filter, type_list<T, rest...>, type_list<current...>> {
-        using type = std::conditional_t<
-            filter<T>::value,
-            typename filtered_types_impl<filter, type_list<rest...>, merged_types_t<type_list<T>, type_list<current...>>>::type,
-            typename filtered_types_impl<filter, type_list<rest...>, type_list<current...>>::type
-        >;
-    };
-    template<template<typename> typename filter, typename... current>
-    struct filtered_types_impl<filter, type_list<>, type_list<current...>> {
-        using type = type_list<current...>;
-    };
-
-}  // namespace detail
-#endif  // DOXYGEN
+// merges lists that contain no repetitions, keeping the first occurrence of each type
+template<typename... Ls>
+struct merged_unique_types : detail::merged_unique_types<Ls...> {};
+template<typename... Ls>
+using merged_unique_types_t = typename merged_unique_types<Ls...>::type;
 
 template<template<typename> typename filter, typename... Ts>
-struct filtered_types : detail::filtered_types_impl<filter, type_list<Ts...>, type_list<>> {};
+struct filtered_types : detail::filtered_types<filter, Ts...> {};
 template<template<typename> typename filter, typename... Ts>
-struct filtered_types<filter, type_list<Ts...>> : detail::filtered_types_impl<filter, type_list<Ts...>, type_list<>> {};
+struct filtered_types<filter, type_list<Ts...>> : detail::filtered_types<filter, Ts...> {};
 template<template<typename> typename filter, typename... Ts>
 using filtered_types_t = typename filtered_types<filter, Ts...>::type;
 
@@ -0,0 +1,62 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/any_expression.hpp>
+
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    adpp::backward::var x;
+    adpp::backward::var y;
+    const auto expression = GENERATE_EXPRESSION(x, y);
+#if USE_TYPE_ERASURE
+    const adpp::backward::any_expression<double, decltype(x), decltype(y)> erased{expression};
+#endif
+
+    constexpr std::size_t N = 10000;
+    std::vector<double> points(2*N);
+    for (unsigned int i = 0; i < N; ++i) {
+        points[2*i] = std::atof(argv[1])*(1.0 + 1e-4*i);
+        points[2*i + 1] = std::atof(argv[2])*(1.0 - 1e-4*i);
+    }
+
+    std::vector<double> values(N);
+    std::vector<double> gradients(2*N);
+#if USE_TYPE_ERASURE
+    // a single indirect call for all points
+    erased.value_and_grad(points, values, gradients);
+#else
+    for (unsigned int i = 0; i < N; ++i) {
+        const auto [value, derivs] = expression.template back_propagate<double>(
+            at(x = points[2*i], y = points[2*i + 1]), adpp::backward::wrt(x, y)
+        );
+        values[i] = value;
+        gradients[2*i] = derivs[x];
+        gradients[2*i + 1] = derivs[y];
+    }
+#endif
+
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        value += values[i];
+        derivs[0] += gradients[2*i];
+        derivs[1] += gradients[2*i + 1];
+    }
+
+    std::cout << "f(x, y) = " << value/N << std::endl;
+    std::cout << "∂r/∂x = " << derivs[0]/N << std::endl;
+    std::cout << "∂r/∂y = " << derivs[1]/N << std::endl;
+
+    return 0;
+}
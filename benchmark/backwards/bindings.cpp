@@ -0,0 +1,41 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <utility>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/bindings.hpp>
+#include <adpp/backward/derivatives.hpp>
+
+#ifndef NUM_SYMBOLS
+#define NUM_SYMBOLS 16
+#endif
+
+// distinct symbols without one declaration each
+template<std::size_t i>
+adpp::backward::var<adpp::backward::dtype::any, i> s;
+
+template<std::size_t... i>
+double lookup_all(double x, double y, const std::index_sequence<i...>&) {
+    const auto values = adpp::backward::at((s<i> = x + y*static_cast<double>(i))...);
+    adpp::backward::derivatives<double, std::remove_cvref_t<decltype(s<i>)>...> derivs;
+
+    // one lookup per symbol in the bindings and in the derivatives
+    ((derivs[s<i>] = values[s<i>]), ...);
+
+    double result = 0.0;
+    for (double d : derivs.as_array())
+        result += d;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    const double x = std::atof(argv[1]);
+    const double y = std::atof(argv[2]);
+    std::cout << "number of symbols = " << NUM_SYMBOLS << std::endl;
+    std::cout << "sum = " << lookup_all(x, y, std::make_index_sequence<NUM_SYMBOLS>{}) << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+
+#include "build_units.hpp"
+
+// Build-time benchmark: the generated translation units either include the headers or import the module.
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    const double x = std::atof(argv[1]);
+    const double y = std::atof(argv[2]);
+    double result = 0.0;
+    for (const auto& unit : registered_units())
+        result += unit(x, y);
+
+    std::cout << "number of units = " << registered_units().size() << std::endl;
+    std::cout << "sum = " << result << std::endl;
+    return 0;
+}
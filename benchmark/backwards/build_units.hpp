@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+using unit_function = double(*)(double, double);
+
+inline std::vector<unit_function>& registered_units() {
+    static std::vector<unit_function> units;
+    return units;
+}
+
+inline bool register_unit(unit_function f) {
+    registered_units().push_back(f);
+    return true;
+}
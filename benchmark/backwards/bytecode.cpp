@@ -0,0 +1,52 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/bytecode.hpp>
+
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    std::array<double, 2> inputs{std::atof(argv[1]), std::atof(argv[2])};
+    adpp::backward::var x;
+    adpp::backward::var y;
+#if USE_BYTECODE
+    auto code = adpp::backward::to_bytecode(GENERATE_EXPRESSION(x, y), adpp::backward::wrt(x, y));
+    std::cout << "instructions = " << code.size() << std::endl;
+#else
+    const auto expression = GENERATE_EXPRESSION(x, y);
+#endif
+
+    constexpr std::size_t N = 10000;
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    std::array gradient{0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        inputs[i%2] *= (i%4 < 2) ? 1.0001 : 0.9999;
+#if USE_BYTECODE
+        value += code.value_and_grad(inputs, gradient);
+#else
+        const auto [eval, derivatives] = expression.template back_propagate<double>(
+            at(x = inputs[0], y = inputs[1]), adpp::backward::wrt(x, y)
+        );
+        value += eval;
+        gradient = derivatives.as_array();
+#endif
+        derivs[0] += gradient[0];
+        derivs[1] += gradient[1];
+    }
+
+    std::cout << "f(x, y) = " << value/N << std::endl;
+    std::cout << "∂r/∂x = " << derivs[0]/N << std::endl;
+    std::cout << "∂r/∂y = " << derivs[1]/N << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/checkpointing.hpp>
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, v)");
+
+    // explicit integration of a nonlinear oscillator
+    adpp::backward::var x;
+    adpp::backward::var v;
+    adpp::backward::let dt;
+    constexpr std::size_t steps = 5000;
+    adpp::backward::time_stepper stepper{
+        bind(x = x + dt*v, v = v - dt*x*x*x - dt*v*0.1),
+        at(dt = 1e-3),
+        CHECKPOINTS
+    };
+
+    constexpr std::size_t N = 20;
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        const double x0 = std::atof(argv[1])*(1.0 + 1e-3*i);
+        const auto [eval, gradient] = stepper.value_and_grad(x*x + v*v, {x0, std::atof(argv[2])}, steps);
+        value += eval;
+        derivs[0] += gradient[0];
+        derivs[1] += gradient[1];
+    }
+
+    const auto& statistics = stepper.statistics();
+    std::cout << "checkpoints = " << stepper.checkpoints() << std::endl;
+    std::cout << "forward steps per sweep = " << statistics.forward_steps << std::endl;
+    std::cout << "f(x, v) = " << value/N << std::endl;
+    std::cout << "∂f/∂x = " << derivs[0]/N << std::endl;
+    std::cout << "∂f/∂v = " << derivs[1]/N << std::endl;
+
+    return 0;
+}
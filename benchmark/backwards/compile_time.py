@@ -0,0 +1,157 @@
+import os
+import json
+import shutil
+import argparse
+import platform
+import itertools
+import subprocess
+import tempfile
+import time
+
+# Generates translation units with expressions of controlled depth, width, number of variables and
+# derivative order, compiles each of them and writes compile times, peak compiler memory and object
+# sizes into a JSON report. With clang, the -ftime-trace output of each translation unit is aggregated.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--depth", type=int, nargs="+", default=[2, 4, 6], help="Nesting depths of the expressions")
+parser.add_argument("--width", type=int, nargs="+", default=[2], help="Number of operands combined per level")
+parser.add_argument("--vars", type=int, nargs="+", default=[2, 8], help="Number of distinct variables")
+parser.add_argument("--order", type=int, nargs="+", default=[1], help="Derivative orders (1 uses back-propagation)")
+parser.add_argument("--repetitions", type=int, default=1, help="Compilations per configuration (the minimum is reported)")
+parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"), help="The C++ compiler to be used")
+parser.add_argument("--flags", default="-std=c++23 -O2", help="Compiler flags")
+parser.add_argument("--include", default=os.path.join(os.path.dirname(__file__), "..", ".."), help="adpp include directory")
+parser.add_argument("--keep", required=False, help="Directory in which to keep the generated sources and traces")
+parser.add_argument("--output", default="compile_time.json", help="Path of the report to be written")
+args = vars(parser.parse_args())
+
+OPERATORS = ["+", "*", "-"]
+
+
+def make_expression(depth: int, width: int, num_vars: int) -> str:
+    leaf = itertools.count()
+    node = itertools.count()
+
+    # operators cycle per node (not per level), such that sibling sub-trees are distinct types
+    def make(level: int) -> str:
+        if level == 0:
+            return f"v{next(leaf) % num_vars}"
+        op = OPERATORS[next(node) % len(OPERATORS)]
+        operands = f" {op} ".join(make(level - 1) for _ in range(width))
+        # bound the values of deep products with an exponential every third level
+        return f"exp({operands})" if level % 3 == 0 else f"({operands})"
+
+    return make(depth)
+
+
+def make_source(depth: int, width: int, num_vars: int, order: int) -> str:
+    symbols = "\n".join(f"    adpp::backward::var v{i};" for i in range(num_vars))
+    values = ", ".join(f"v{i} = x + {i}.0" for i in range(num_vars))
+    if order == 1:
+        derivative = "    const auto derivs = adpp::backward::grad(expression, values);\n" \
+                     "    return derivs[v0];"
+    else:
+        derivative = f"    return adpp::backward::derivative_of(expression, adpp::backward::wrt(v0), values, adpp::order<{order}>{{}});"
+    return "\n".join([
+        "#include <adpp/backward.hpp>",
+        "",
+        "double benchmark(double x) {",
+        symbols,
+        f"    const auto expression = {make_expression(depth, width, num_vars)};",
+        f"    const auto values = adpp::backward::at({values});",
+        derivative,
+        "}",
+        ""
+    ])
+
+
+def aggregate_time_trace(path: str) -> dict:
+    # clang writes one "Total <category>" event per category, with the accumulated duration in microseconds
+    with open(path) as trace_file:
+        events = json.load(trace_file).get("traceEvents", [])
+    return {
+        event["name"][len("Total "):]: event["dur"]/1e6
+        for event in events if event.get("name", "").startswith("Total ") and "dur" in event
+    }
+
+
+def compile_unit(source_path: str, object_path: str, time_trace: bool) -> dict:
+    command = [args["compiler"], *args["flags"].split(), f"-I{args['include']}", "-c", source_path, "-o", object_path]
+    if time_trace:
+        command.append("-ftime-trace")
+
+    # stderr goes to a file, since a full pipe would block the compiler while we wait for it to exit
+    with tempfile.TemporaryFile(mode="w+") as error_file:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stderr=error_file)
+        _, status, usage = os.wait4(process.pid, 0)
+        wall_time = time.perf_counter() - start
+        error_file.seek(0)
+        errors = error_file.read()
+
+    result = {
+        "success": os.waitstatus_to_exitcode(status) == 0,
+        "wall_time": wall_time,
+        "user_time": usage.ru_utime,
+        "system_time": usage.ru_stime,
+        # kilobytes on Linux, bytes on macOS
+        "peak_memory_mb": usage.ru_maxrss/(1024*1024 if platform.system() == "Darwin" else 1024)
+    }
+    if not result["success"]:
+        result["errors"] = errors[:4000]
+        return result
+
+    result["object_size"] = os.path.getsize(object_path)
+    trace_path = os.path.splitext(object_path)[0] + ".json"
+    if time_trace and os.path.exists(trace_path):
+        result["time_trace"] = aggregate_time_trace(trace_path)
+    return result
+
+
+def supports_time_trace(directory: str) -> bool:
+    probe = os.path.join(directory, "probe.cpp")
+    with open(probe, "w") as probe_file:
+        probe_file.write("int main() { return 0; }\n")
+    return subprocess.run(
+        [args["compiler"], "-ftime-trace", "-c", probe, "-o", os.path.join(directory, "probe.o")],
+        stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL
+    ).returncode == 0
+
+
+work_dir = args["keep"] or tempfile.mkdtemp(prefix="adpp_compile_time_")
+os.makedirs(work_dir, exist_ok=True)
+time_trace = supports_time_trace(work_dir)
+
+results = []
+for depth, width, num_vars, order in itertools.product(args["depth"], args["width"], args["vars"], args["order"]):
+    name = f"d{depth}_w{width}_v{num_vars}_o{order}"
+    source_path = os.path.join(work_dir, f"{name}.cpp")
+    object_path = os.path.join(work_dir, f"{name}.o")
+    with open(source_path, "w") as source_file:
+        source_file.write(make_source(depth, width, num_vars, order))
+
+    runs = [compile_unit(source_path, object_path, time_trace) for _ in range(args["repetitions"])]
+    best = min(runs, key=lambda r: r["wall_time"])
+    results.append({
+        "name": name,
+        "depth": depth,
+        "width": width,
+        "vars": num_vars,
+        "order": order,
+        "leaves": width**depth,
+        **best
+    })
+    status = f"{best['wall_time']:.2f} s, {best['peak_memory_mb']:.0f} MB" if best["success"] else "failed"
+    print(f"{name}: {status}")
+
+with open(args["output"], "w") as report:
+    json.dump({
+        "compiler": args["compiler"],
+        "flags": args["flags"],
+        "time_trace": time_trace,
+        "results": results
+    }, report, indent=2)
+print(f"Wrote report to {args['output']}")
+
+if args["keep"] is None:
+    shutil.rmtree(work_dir)
@@ -13,6 +13,12 @@
 
 #include "test_expr.hpp"
 
+#if USE_OUTLINING
+// outlines the repeated units of the benchmark expression and the sums above them
+template<typename E> requires(adpp::backward::tree_size_v<E> >= 16)
+struct adpp::backward::outline<E> : std::true_type {};
+#endif
+
 int main(int argc, char** argv) {
     if (argc < 3)
         throw std::runtime_error("Expected two input arguments (x, y)");
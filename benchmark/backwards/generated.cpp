@@ -0,0 +1,34 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <array>
+
+#include "generated_kernel.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    // the kernel has been generated ahead of time, this translation unit does not instantiate any expressions
+    const std::array inputs{std::atof(argv[1]), std::atof(argv[2])};
+
+    constexpr std::size_t N = 10000;
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    std::array gradient{0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        value += generated_kernel_gradient(inputs.data(), gradient.data());
+        derivs[0] += gradient[0];
+        derivs[1] += gradient[1];
+    }
+
+    value /= N;
+    derivs[0] /= N;
+    derivs[1] /= N;
+
+    std::cout << "f(x, y) = " << value << std::endl;
+    std::cout << "∂r/∂x = " << derivs[0] << std::endl;
+    std::cout << "∂r/∂y = " << derivs[1] << std::endl;
+
+    return 0;
+}
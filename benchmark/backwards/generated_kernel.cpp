@@ -0,0 +1,22 @@
+#include <stdexcept>
+#include <fstream>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/codegen.hpp>
+
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected the paths of the source and header files to be written");
+
+    adpp::backward::var x;
+    adpp::backward::var y;
+    std::ofstream source{argv[1]};
+    std::ofstream header{argv[2]};
+    adpp::backward::write_kernel_source(source, "generated_kernel", GENERATE_EXPRESSION(x, y), adpp::backward::wrt(x, y));
+    adpp::backward::write_kernel_header(header, "generated_kernel");
+    return 0;
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <ostream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define BENCH_HAS_PERF_EVENT 1
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#else
+#define BENCH_HAS_PERF_EVENT 0
+#endif
+
+// In-process measurements of single calls, e.g. the gradient of an expression at a point. Calls are timed in
+// batches (samples) for the mean time per call, and one by one for the percentiles, since percentiles of batch
+// means hide the distribution of single calls. The overhead of reading the clock is subtracted from the latter.
+namespace bench {
+
+struct options {
+    std::size_t samples = 200;
+    std::size_t batch = 0;  // calls per sample, 0 calibrates it such that a sample takes at least min_sample_ns
+    double min_sample_ns = 5000.0;
+    std::size_t single_calls = 1000;  // calls timed one by one for the percentiles, 0 takes them over the samples
+    std::string filter;  // only measure the cases whose "workload/operation/implementation" contains it
+    std::string output;  // JSON report to be written (if not empty)
+
+    static options from_args(int argc, char** argv) {
+        options opts;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for argument " + std::string{arg});
+            if (arg == "--samples") opts.samples = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--batch") opts.batch = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--single-calls") opts.single_calls = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--filter") opts.filter = argv[++i];
+            else if (arg == "--output") opts.output = argv[++i];
+            else throw std::runtime_error("Unknown argument " + std::string{arg});
+        }
+        if (opts.samples == 0)
+            throw std::runtime_error("Number of samples must be positive");
+        return opts;
+    }
+};
+
+struct result {
+    std::string workload;
+    std::string operation;
+    std::string implementation;
+    std::size_t calls;
+    double ns_per_call;
+    double p50_ns;
+    double p99_ns;
+    double instructions_per_call;  // NaN if the instructions could not be counted
+};
+
+// keeps the compiler from discarding the computation of the given value
+template<typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Counts the retired user-space instructions of this thread via perf_event_open. These are far less noisy
+// than wall time, but the kernel may forbid it (see /proc/sys/kernel/perf_event_paranoid), in which case
+// the counter is invalid and the reports only contain times.
+class instruction_counter {
+ public:
+    instruction_counter() {
+#if BENCH_HAS_PERF_EVENT
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(perf_event_attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    instruction_counter(const instruction_counter&) = delete;
+    instruction_counter& operator=(const instruction_counter&) = delete;
+
+    ~instruction_counter() {
+#if BENCH_HAS_PERF_EVENT
+        if (_fd >= 0)
+            close(_fd);
+#endif
+    }
+
+    bool is_valid() const noexcept {
+        return _fd >= 0;
+    }
+
+    void start() {
+#if BENCH_HAS_PERF_EVENT
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // returns the number of instructions since the last call to start
+    double stop() {
+#if BENCH_HAS_PERF_EVENT
+        long long count = 0;
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(_fd, &count, sizeof(count)) == sizeof(count))
+                return static_cast<double>(count);
+        }
+#endif
+        return std::nan("");
+    }
+
+ private:
+    int _fd = -1;
+};
+
+class suite {
+    using clock = std::chrono::steady_clock;
+
+ public:
+    explicit suite(options opts)
+    : _options{std::move(opts)}
+    , _clock_overhead_ns{_measure_clock_overhead()}
+    {}
+
+    template<typename F>
+    void measure(std::string_view workload, std::string_view operation, std::string_view implementation, F&& f) {
+        const std::string name = std::string{workload} + "/" + std::string{operation} + "/" + std::string{implementation};
+        if (!_options.filter.empty() && name.find(_options.filter) == std::string::npos)
+            return;
+
+        const auto run_batch = [&] (std::size_t n) {
+            const auto start = clock::now();
+            for (std::size_t i = 0; i < n; ++i)
+                do_not_optimize(f());
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        };
+
+        std::size_t batch = _options.batch;
+        if (batch == 0)
+            for (batch = 1; batch < (std::size_t{1} << 24) && run_batch(batch) < _options.min_sample_ns; batch *= 2);
+        else
+            run_batch(batch);  // warmup
+
+        std::vector<double> ns_per_call(_options.samples);
+        double total_ns = 0.0;
+        _counter.start();
+        for (double& sample : ns_per_call) {
+            const double ns = run_batch(batch);
+            total_ns += ns;
+            sample = ns/static_cast<double>(batch);
+        }
+        const double instructions = _counter.stop();
+
+        std::vector<double> latencies = _options.single_calls == 0 ? ns_per_call : std::vector<double>{};
+        for (std::size_t i = 0; i < _options.single_calls; ++i) {
+            const auto start = clock::now();
+            do_not_optimize(f());
+            const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            latencies.push_back(std::max(0.0, ns - _clock_overhead_ns));
+        }
+        std::ranges::sort(latencies);
+
+        const std::size_t n = ns_per_call.size();
+        const std::size_t m = latencies.size();
+        _results.push_back({
+            .workload = std::string{workload},
+            .operation = std::string{operation},
+            .implementation = std::string{implementation},
+            .calls = n*batch,
+            .ns_per_call = total_ns/static_cast<double>(n*batch),
+            .p50_ns = latencies[m/2],
+            .p99_ns = latencies[std::min(m - 1, m*99/100)],
+            .instructions_per_call = instructions/static_cast<double>(n*batch)
+        });
+        _print(_results.back());
+    }
+
+    // throws if the values differ by more than the given relative tolerance
+    void check(std::string_view what, double actual, double expected, double rtol = 1e-6) const {
+        if (std::abs(actual - expected) > rtol*std::max(1.0, std::abs(expected)))
+            throw std::runtime_error(
+                "Mismatch in " + std::string{what} + ": "
+                + std::to_string(actual) + " != " + std::to_string(expected)
+            );
+    }
+
+    const std::vector<result>& results() const noexcept {
+        return _results;
+    }
+
+    void write_json(std::ostream& out) const {
+        out << std::setprecision(6) << "{\n";
+        out << "  \"samples\": " << _options.samples << ",\n";
+        out << "  \"single_calls\": " << _options.single_calls << ",\n";
+        out << "  \"clock_overhead_ns\": " << _clock_overhead_ns << ",\n";
+        out << "  \"results\": [";
+        for (std::size_t i = 0; i < _results.size(); ++i) {
+            const result& r = _results[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"workload\": \"" << r.workload << "\", "
+                << "\"operation\": \"" << r.operation << "\", "
+                << "\"implementation\": \"" << r.implementation << "\", "
+                << "\"calls\": " << r.calls << ", "
+                << "\"ns_per_call\": " << r.ns_per_call << ", "
+                << "\"p50_ns\": " << r.p50_ns << ", "
+                << "\"p99_ns\": " << r.p99_ns << ", "
+                << "\"instructions_per_call\": ";
+            if (std::isnan(r.instructions_per_call))
+                out << "null}";
+            else
+                out << r.instructions_per_call << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+ private:
+    // minimum time between two consecutive readings of the clock
+    static double _measure_clock_overhead() {
+        double overhead = std::numeric_limits<double>::max();
+        for (int i = 0; i < 1000; ++i) {
+            const auto start = clock::now();
+            overhead = std::min(overhead, std::chrono::duration<double, std::nano>(clock::now() - start).count());
+        }
+        return overhead;
+    }
+
+    static void _print(const result& r) {
+        std::cout << std::left << std::setw(16) << r.workload
+                  << std::setw(20) << r.operation
+                  << std::setw(10) << r.implementation
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.ns_per_call << " ns/call"
+                  << std::setw(12) << r.p50_ns << " p50"
+                  << std::setw(12) << r.p99_ns << " p99";
+        if (!std::isnan(r.instructions_per_call))
+            std::cout << std::setw(12) << r.instructions_per_call << " instructions";
+        std::cout << std::endl;
+    }
+
+    options _options;
+    double _clock_overhead_ns;
+    instruction_counter _counter;
+    std::vector<result> _results;
+};
+
+// central difference of the given function (of a point) w.r.t. the coordinate i
+template<typename F, typename P>
+inline double central_difference(F&& f, P point, std::size_t i) {
+    const double h = 1e-6*std::max(1.0, std::abs(point[i]));
+    const double x = point[i];
+    point[i] = x + h;
+    const double forward = f(point);
+    point[i] = x - h;
+    const double backward = f(point);
+    return (forward - backward)/(2.0*h);
+}
+
+}  // namespace bench
@@ -0,0 +1,59 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/incremental.hpp>
+
+#include "test_expr.hpp"
+
+#define PARTIAL_EXPRESSION(a, b) ADD_16(UNIT_EXPRESSION(a, b))
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    std::array<double, 4> values{std::atof(argv[1]), std::atof(argv[2]), std::atof(argv[1]), std::atof(argv[2])};
+    adpp::backward::var a;
+    adpp::backward::var b;
+    adpp::backward::var c;
+    adpp::backward::var d;
+    const auto expression = PARTIAL_EXPRESSION(a, b) + PARTIAL_EXPRESSION(b, c) + PARTIAL_EXPRESSION(c, d);
+
+#if USE_INCREMENTAL
+    adpp::backward::incremental_evaluator evaluator{
+        expression, at(a = values[0], b = values[1], c = values[2], d = values[3])
+    };
+#endif
+
+    // vary one input at a time, such that only parts of the expression are affected
+    constexpr std::size_t N = 10000;
+    double value = 0.0;
+    std::array derivs{0.0, 0.0, 0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        values[i%4] *= (i%2 == 0) ? 1.0001 : 0.9999;
+#if USE_INCREMENTAL
+        evaluator.set(a = values[0], b = values[1], c = values[2], d = values[3]);
+        const auto [eval, gradient] = evaluator.value_and_grad();
+#else
+        const auto args = at(a = values[0], b = values[1], c = values[2], d = values[3]);
+        const auto eval = expression.evaluate(args);
+        const auto gradient = grad(expression, args);
+#endif
+        value += eval;
+        derivs[0] += gradient[a];
+        derivs[1] += gradient[b];
+        derivs[2] += gradient[c];
+        derivs[3] += gradient[d];
+    }
+
+    std::cout << "f = " << value/N << std::endl;
+    for (unsigned int i = 0; i < 4; ++i)
+        std::cout << "∂f/∂x_" << i << " = " << derivs[i]/N << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <type_traits>
+
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/concepts.hpp>
+
+// The previous, recursive implementation of the symbol traits, kept as a reference for the compile-time benchmark.
+namespace legacy {
+
+using adpp::type_list;
+using adpp::is_any_of_v;
+
+template<typename T, typename... Ts>
+struct unique_types {
+    using type = std::conditional_t<
+        is_any_of_v<T, Ts...>,
+        typename unique_types<Ts...>::type,
+        typename unique_types<type_list<T>, Ts...>::type
+    >;
+};
+
+template<typename T>
+struct unique_types<T> : std::type_identity<type_list<T>> {};
+
+template<typename... Ts, typename T, typename... Rest>
+struct unique_types<type_list<Ts...>, T, Rest...> {
+    using type = std::conditional_t<
+        is_any_of_v<T, Ts...>,
+        typename unique_types<type_list<Ts...>, Rest...>::type,
+        typename unique_types<type_list<Ts..., T>, Rest...>::type
+    >;
+};
+
+template<typename... Ts>
+struct unique_types<type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
+
+template<typename A, typename B>
+struct merged_types;
+
+template<typename... As, typename... Bs>
+struct merged_types<type_list<As...>, type_list<Bs...>> {
+    using type = type_list<As..., Bs...>;
+};
+
+template<typename L>
+struct unique_list;
+template<typename T, typename... Ts>
+struct unique_list<type_list<T, Ts...>> : unique_types<T, Ts...> {};
+template<>
+struct unique_list<type_list<>> : std::type_identity<type_list<>> {};
+
+template<typename...>
+struct symbols_impl;
+
+template<typename E, typename... Ts> requires(adpp::backward::is_symbol_v<std::remove_cvref_t<E>>)
+struct symbols_impl<E, type_list<Ts...>> {
+    using type = typename unique_types<type_list<Ts...>, std::remove_cvref_t<E>>::type;
+};
+
+template<typename E, typename... Ts> requires(!adpp::backward::is_symbol_v<std::remove_cvref_t<E>>)
+struct symbols_impl<E, type_list<Ts...>> {
+    using type = typename symbols_impl<adpp::backward::operands_t<E>, type_list<Ts...>>::type;
+};
+
+template<typename E0, typename... Es, typename... Ts>
+struct symbols_impl<type_list<E0, Es...>, type_list<Ts...>> {
+    using type = typename unique_list<
+        typename merged_types<
+            typename symbols_impl<E0, type_list<Ts...>>::type,
+            typename symbols_impl<type_list<Es...>, type_list<Ts...>>::type
+        >::type
+    >::type;
+};
+
+template<typename... Ts> struct symbols_impl<type_list<>, type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
+
+template<typename E>
+using symbols_t = typename symbols_impl<E, type_list<>>::type;
+
+}  // namespace legacy
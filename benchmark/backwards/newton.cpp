@@ -0,0 +1,57 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/compile.hpp>
+
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    const double x0 = std::atof(argv[1]);
+    const double yv = std::atof(argv[2]);
+    adpp::backward::var x;
+    adpp::backward::var y;
+
+    // solve f(x, y) = target for x with y fixed, restarting from x0 many times
+    const auto expression = GENERATE_EXPRESSION(x, y);
+    const double target = 2.0*expression.evaluate(at(x = x0, y = yv));
+
+#if USE_COMPILED
+    const auto f = adpp::backward::compile(expression, wrt(x, y));
+#else
+    const adpp::backward::function f{GENERATE_EXPRESSION(x, y)};
+#endif
+
+    constexpr std::size_t N = 10000;
+    double solution_sum = 0.0;
+    for (unsigned int i = 0; i < N; ++i) {
+        double solution = x0;
+        for (int it = 0; it < 20; ++it) {
+#if USE_COMPILED
+            const auto [value, gradient] = f.value_and_grad(solution, yv);
+            const double residual = value - target;
+            const double slope = gradient[0];
+#else
+            // one sweep for the value and the derivatives, as in the compiled variant
+            const auto [value, derivs] = f.template back_propagate<double>(at(x = solution, y = yv), wrt(x, y));
+            const double residual = value - target;
+            const double slope = derivs[x];
+#endif
+            if (std::abs(residual) < 1e-10)
+                break;
+            solution -= residual/slope;
+        }
+        solution_sum += solution;
+    }
+
+    std::cout << "x = " << solution_sum/N << std::endl;
+    return 0;
+}
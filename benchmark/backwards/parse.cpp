@@ -0,0 +1,52 @@
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/parse.hpp>
+
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+    // model file with many formulas, written in the format of `export_to`
+    adpp::backward::var x;
+    adpp::backward::var y;
+    std::ostringstream formula;
+    formula << (GENERATE_EXPRESSION(x, y)).with(x = "x", y = "y");
+
+    constexpr std::size_t N = 1000;
+    std::string model;
+    for (unsigned int i = 0; i < N; ++i)
+        model.append(formula.str()).append("\n");
+
+    adpp::backward::expression_parser parser{"x", "y"};
+    const auto start = std::chrono::steady_clock::now();
+    auto codes = parser.parse_lines(model);
+    const auto end = std::chrono::steady_clock::now();
+
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    std::array gradient{0.0, 0.0};
+    const std::array inputs{std::atof(argv[1]), std::atof(argv[2])};
+    for (auto& code : codes) {
+        value += code.value_and_grad(inputs, gradient);
+        derivs[0] += gradient[0];
+        derivs[1] += gradient[1];
+    }
+
+    std::cout << "model size = " << model.size() << " bytes" << std::endl;
+    std::cout << "parse time = " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    std::cout << "f(x, y) = " << value/N << std::endl;
+    std::cout << "∂r/∂x = " << derivs[0]/N << std::endl;
+    std::cout << "∂r/∂y = " << derivs[1]/N << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <tuple>
+
+#include <adpp/type_traits.hpp>
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/expression.hpp>
+
+#include "test_expr.hpp"
+#include "legacy_symbols.hpp"
+
+// unit with 16 distinct symbols and 32 nodes
+#define UNIT_16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+    ((a*b + c*d)*(e - f/g) + exp(h)*i - j*(k + l) + m/(n*o) - p)
+
+// the repeated pair of units has 65 nodes, i.e. the expressions have about 500, 2000 or 4000 nodes
+#ifndef NUM_REPETITIONS
+#define NUM_REPETITIONS 8
+#endif
+
+#if NUM_REPETITIONS == 8
+#define REPEAT(x) ADD_8(x)
+#elif NUM_REPETITIONS == 32
+#define REPEAT(x) ADD_32(x)
+#else
+#define REPEAT(x) ADD_64(x)
+#endif
+
+template<typename... S>
+auto make_expression(const S&... s) {
+    // the same symbols appear in many places of the tree
+    const auto [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p] = std::tie(s...);
+    return REPEAT(UNIT_16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) + UNIT_16(p, o, n, m, l, k, j, i, h, g, f, e, d, c, b, a));
+}
+
+int main() {
+    adpp::backward::var s0; adpp::backward::var s1; adpp::backward::var s2; adpp::backward::var s3;
+    adpp::backward::var s4; adpp::backward::var s5; adpp::backward::var s6; adpp::backward::var s7;
+    adpp::backward::var s8; adpp::backward::var s9; adpp::backward::var s10; adpp::backward::var s11;
+    adpp::backward::var s12; adpp::backward::var s13; adpp::backward::var s14; adpp::backward::var s15;
+    using expression_t = decltype(make_expression(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15));
+
+#if USE_LEGACY_TRAITS
+    using symbols = legacy::symbols_t<expression_t>;
+#else
+    using symbols = adpp::backward::symbols_t<expression_t>;
+#endif
+    static_assert(adpp::type_list_size_v<symbols> == 16);
+    std::cout << "number of symbols = " << adpp::type_list_size_v<symbols> << std::endl;
+    return 0;
+}
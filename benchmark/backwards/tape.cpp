@@ -0,0 +1,60 @@
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <array>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/tape.hpp>
+
+#if !USE_PREACCUMULATION
+// tape nodes combine with scalars, not with compile-time constants
+#define USE_SCALAR_LITERALS 1
+#endif
+#include "test_expr.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected two input arguments (x, y)");
+
+#if USE_HASH_CONSING
+    adpp::backward::tape t{1024, adpp::backward::deduplication::on};
+#else
+    adpp::backward::tape t{1024, adpp::backward::deduplication::off};
+#endif
+
+    // record once, the generated expression repeats the same unit expression many times
+    std::array<double, 2> inputs{std::atof(argv[1]), std::atof(argv[2])};
+    auto x = t.input(inputs[0]);
+    auto y = t.input(inputs[1]);
+#if USE_PREACCUMULATION
+    // record the static expression as a single entry with its local gradient
+    adpp::backward::var a;
+    adpp::backward::var b;
+    auto expression = t.record(GENERATE_EXPRESSION(a, b), at(a = x, b = y));
+#else
+    auto expression = GENERATE_EXPRESSION(x, y);
+#endif
+
+    // ... and replay many times with new input values
+    constexpr std::size_t N = 10000;
+    double value = 0.0;
+    std::array derivs{0.0, 0.0};
+    std::array gradient{0.0, 0.0};
+    for (unsigned int i = 0; i < N; ++i) {
+        inputs[i%2] *= (i%4 < 2) ? 1.0001 : 0.9999;
+        value += t.value_and_grad(inputs, expression, gradient);
+        derivs[0] += gradient[0];
+        derivs[1] += gradient[1];
+    }
+
+    const auto statistics = t.statistics();
+    std::cout << "recorded nodes = " << statistics.recorded << std::endl;
+    std::cout << "unique nodes = " << statistics.unique << std::endl;
+    std::cout << "deduplication ratio = " << statistics.deduplication_ratio() << std::endl;
+    std::cout << "f(x, y) = " << value/N << std::endl;
+    std::cout << "∂r/∂x = " << derivs[0]/N << std::endl;
+    std::cout << "∂r/∂y = " << derivs[1]/N << std::endl;
+
+    return 0;
+}
@@ -7,5 +7,15 @@
 #define ADD_32(x) ADD_16(x) + ADD_16(x)
 #define ADD_64(x) ADD_32(x) + ADD_32(x)
 
-#define UNIT_EXPRESSION(a, b) 2*a*((a + b)*b*4 + (a*b) + b*8)
+// literals are compile-time constants, which share one type per value (scalars passed to the
+// operators instead become a new leaf type each), unless scalars are requested (e.g. for other libraries)
+#if USE_SCALAR_LITERALS
+#define LITERAL(v) v
+#else
+#include <adpp/backward/symbols.hpp>
+using namespace adpp::backward::literals;
+#define LITERAL(v) v##_c
+#endif
+
+#define UNIT_EXPRESSION(a, b) LITERAL(2)*a*((a + b)*b*LITERAL(4) + (a*b) + b*LITERAL(8))
 #define GENERATE_EXPRESSION(a, b) ADD_64(UNIT_EXPRESSION(a, b))
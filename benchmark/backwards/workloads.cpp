@@ -0,0 +1,396 @@
+#include <cmath>
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <autodiff/reverse/var.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+
+#include "harness.hpp"
+
+// Standard workloads, each measured with adpp (evaluate, grad, derivative_of and higher-order derivatives),
+// with hand-derived derivatives and with the reverse mode of autodiff. The adpp results are checked against
+// the hand-derived ones (and higher orders against finite differences) before they are timed.
+
+using namespace adpp::backward::literals;
+
+// the functions evaluated with doubles (hand-derived) and autodiff
+template<typename T>
+T rosenbrock(const T& x, const T& y) {
+    return (1.0 - x)*(1.0 - x) + 100.0*(y - x*x)*(y - x*x);
+}
+
+inline constexpr double mlp_weights[3][3]{{0.5, -0.25, 0.75}, {0.3, 0.6, -0.2}, {-0.7, 0.8, 0.2}};
+inline constexpr double mlp_biases[3]{0.1, -0.4, 0.05};
+inline constexpr double mlp_outputs[3]{1.5, -0.5, 0.25};
+
+template<typename T>
+T mlp(const T& x1, const T& x2, const T& x3) {
+    using std::exp;
+    T result = 0.0;
+    for (int j = 0; j < 3; ++j) {
+        const T z = mlp_weights[j][0]*x1 + mlp_weights[j][1]*x2 + mlp_weights[j][2]*x3 + mlp_biases[j];
+        result = result + mlp_outputs[j]*exp(z)/(1.0 + exp(z));
+    }
+    return result;
+}
+
+// compressible neo-Hookean energy of a plane deformation gradient (mu = 2, lambda = 4), in which the
+// volumetric terms use J - 1 in place of log(J), since the expression templates do not provide logarithms
+template<typename T>
+T neo_hookean(const T& F11, const T& F12, const T& F21, const T& F22) {
+    const T I1 = F11*F11 + F12*F12 + F21*F21 + F22*F22;
+    const T J = F11*F22 - F12*F21;
+    return (I1 - 2.0) - 2.0*(J - 1.0) + 2.0*(J - 1.0)*(J - 1.0);
+}
+
+// pair sum of three particles in the plane (epsilon = sigma = 1), with the first one fixed at the origin
+template<typename T>
+T lennard_jones(const T& x1, const T& y1, const T& x2, const T& y2) {
+    const auto pair = [] (const T& r2) -> T {
+        const T inv6 = 1.0/(r2*r2*r2);
+        return 4.0*(inv6*inv6 - inv6);
+    };
+    return pair(x1*x1 + y1*y1) + pair(x2*x2 + y2*y2) + pair((x1 - x2)*(x1 - x2) + (y1 - y2)*(y1 - y2));
+}
+
+// right-hand side of the (stiff) Robertson chemical kinetics problem
+template<typename T>
+std::array<T, 3> robertson(const T& y1, const T& y2, const T& y3) {
+    return {
+        1e4*y2*y3 - 0.04*y1,
+        0.04*y1 - 1e4*y2*y3 - 3e7*y2*y2,
+        3e7*y2*y2
+    };
+}
+
+
+void rosenbrock_workload(bench::suite& suite) {
+    adpp::backward::var<double> x;
+    adpp::backward::var<double> y;
+    const auto f = (1_c - x)*(1_c - x) + 100_c*(y - x*x)*(y - x*x);
+
+    std::array p{-1.2, 1.0};
+    const auto values = [&] (const auto& q) { return at(x = q[0], y = q[1]); };
+    const auto hand_grad = [] (const auto& q) {
+        return std::array{-2.0*(1.0 - q[0]) - 400.0*q[0]*(q[1] - q[0]*q[0]), 200.0*(q[1] - q[0]*q[0])};
+    };
+    const auto hand_second = [] (const auto& q) { return 2.0 - 400.0*q[1] + 1200.0*q[0]*q[0]; };
+    const auto hand_third = [] (const auto& q) { return 2400.0*q[0]; };
+
+    const auto g = grad(f, values(p));
+    suite.check("rosenbrock value", f.evaluate(values(p)), rosenbrock(p[0], p[1]));
+    suite.check("rosenbrock ∂f/∂x", g[x], hand_grad(p)[0]);
+    suite.check("rosenbrock ∂f/∂y", g[y], hand_grad(p)[1]);
+    suite.check("rosenbrock ∂²f/∂x²", derivative_of(f, wrt(x), values(p), adpp::order<2>{}), hand_second(p));
+    suite.check("rosenbrock ∂³f/∂x³", derivative_of(f, wrt(x), values(p), adpp::order<3>{}), hand_third(p));
+
+    suite.measure("rosenbrock", "evaluate", "adpp", [&] { bench::do_not_optimize(p); return f.evaluate(values(p)); });
+    suite.measure("rosenbrock", "evaluate", "hand", [&] { bench::do_not_optimize(p); return rosenbrock(p[0], p[1]); });
+    suite.measure("rosenbrock", "evaluate", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var ax = p[0], ay = p[1];
+        return double(rosenbrock(ax, ay));
+    });
+    suite.measure("rosenbrock", "grad", "adpp", [&] { bench::do_not_optimize(p); return grad(f, values(p)); });
+    suite.measure("rosenbrock", "grad", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p); });
+    suite.measure("rosenbrock", "grad", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var ax = p[0], ay = p[1];
+        return derivatives(rosenbrock(ax, ay), wrt(ax, ay));
+    });
+    suite.measure("rosenbrock", "derivative_of", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(x), values(p));
+    });
+    suite.measure("rosenbrock", "derivative_of", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p)[0]; });
+    suite.measure("rosenbrock", "second_derivative", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(x), values(p), adpp::order<2>{});
+    });
+    suite.measure("rosenbrock", "second_derivative", "hand", [&] { bench::do_not_optimize(p); return hand_second(p); });
+    suite.measure("rosenbrock", "third_derivative", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(x), values(p), adpp::order<3>{});
+    });
+    suite.measure("rosenbrock", "third_derivative", "hand", [&] { bench::do_not_optimize(p); return hand_third(p); });
+}
+
+
+void mlp_workload(bench::suite& suite) {
+    adpp::backward::var<double> x1;
+    adpp::backward::var<double> x2;
+    adpp::backward::var<double> x3;
+    const auto z1 = 0.5_c*x1 - 0.25_c*x2 + 0.75_c*x3 + 0.1_c;
+    const auto z2 = 0.3_c*x1 + 0.6_c*x2 - 0.2_c*x3 - 0.4_c;
+    const auto z3 = 0.8_c*x2 - 0.7_c*x1 + 0.2_c*x3 + 0.05_c;
+    const auto f = 1.5_c*exp(z1)/(1_c + exp(z1)) - 0.5_c*exp(z2)/(1_c + exp(z2)) + 0.25_c*exp(z3)/(1_c + exp(z3));
+
+    std::array p{0.3, -0.8, 1.1};
+    const auto values = [&] (const auto& q) { return at(x1 = q[0], x2 = q[1], x3 = q[2]); };
+    const auto hand_grad = [] (const auto& q) {
+        std::array<double, 3> result{};
+        for (int j = 0; j < 3; ++j) {
+            const auto& w = mlp_weights[j];
+            const double s = 1.0/(1.0 + std::exp(-(w[0]*q[0] + w[1]*q[1] + w[2]*q[2] + mlp_biases[j])));
+            for (int i = 0; i < 3; ++i)
+                result[i] += mlp_outputs[j]*s*(1.0 - s)*w[i];
+        }
+        return result;
+    };
+    const auto first = [&] (const auto& q) { return derivative_of(f, wrt(x1), values(q)); };
+    const auto second = [&] (const auto& q) { return derivative_of(f, wrt(x1), values(q), adpp::order<2>{}); };
+
+    const auto g = grad(f, values(p));
+    suite.check("mlp value", f.evaluate(values(p)), mlp(p[0], p[1], p[2]));
+    suite.check("mlp ∂f/∂x1", g[x1], hand_grad(p)[0]);
+    suite.check("mlp ∂f/∂x2", g[x2], hand_grad(p)[1]);
+    suite.check("mlp ∂f/∂x3", g[x3], hand_grad(p)[2]);
+    suite.check("mlp ∂²f/∂x1²", second(p), bench::central_difference(first, p, 0), 1e-5);
+    suite.check(
+        "mlp ∂³f/∂x1³", derivative_of(f, wrt(x1), values(p), adpp::order<3>{}),
+        bench::central_difference(second, p, 0), 1e-5
+    );
+
+    suite.measure("mlp", "evaluate", "adpp", [&] { bench::do_not_optimize(p); return f.evaluate(values(p)); });
+    suite.measure("mlp", "evaluate", "hand", [&] { bench::do_not_optimize(p); return mlp(p[0], p[1], p[2]); });
+    suite.measure("mlp", "evaluate", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], a2 = p[1], a3 = p[2];
+        return double(mlp(a1, a2, a3));
+    });
+    suite.measure("mlp", "grad", "adpp", [&] { bench::do_not_optimize(p); return grad(f, values(p)); });
+    suite.measure("mlp", "grad", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p); });
+    suite.measure("mlp", "grad", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], a2 = p[1], a3 = p[2];
+        return derivatives(mlp(a1, a2, a3), wrt(a1, a2, a3));
+    });
+    suite.measure("mlp", "derivative_of", "adpp", [&] { bench::do_not_optimize(p); return first(p); });
+    suite.measure("mlp", "second_derivative", "adpp", [&] { bench::do_not_optimize(p); return second(p); });
+    suite.measure("mlp", "third_derivative", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(x1), values(p), adpp::order<3>{});
+    });
+}
+
+
+void neo_hookean_workload(bench::suite& suite) {
+    adpp::backward::var<double> F11;
+    adpp::backward::var<double> F12;
+    adpp::backward::var<double> F21;
+    adpp::backward::var<double> F22;
+    const auto I1 = F11*F11 + F12*F12 + F21*F21 + F22*F22;
+    const auto J = F11*F22 - F12*F21;
+    const auto f = (I1 - 2_c) - 2_c*(J - 1_c) + 2_c*(J - 1_c)*(J - 1_c);
+
+    std::array p{1.1, 0.2, 0.1, 0.9};
+    const auto values = [&] (const auto& q) { return at(F11 = q[0], F12 = q[1], F21 = q[2], F22 = q[3]); };
+    const auto hand_grad = [] (const auto& q) {
+        const double scale = 4.0*(q[0]*q[3] - q[1]*q[2] - 1.0) - 2.0;
+        return std::array{2.0*q[0] + scale*q[3], 2.0*q[1] - scale*q[2], 2.0*q[2] - scale*q[1], 2.0*q[3] + scale*q[0]};
+    };
+    const auto hand_second = [] (const auto& q) { return 2.0 + 4.0*q[3]*q[3]; };
+
+    const auto g = grad(f, values(p));
+    suite.check("neo_hookean value", f.evaluate(values(p)), neo_hookean(p[0], p[1], p[2], p[3]));
+    suite.check("neo_hookean ∂W/∂F11", g[F11], hand_grad(p)[0]);
+    suite.check("neo_hookean ∂W/∂F12", g[F12], hand_grad(p)[1]);
+    suite.check("neo_hookean ∂W/∂F21", g[F21], hand_grad(p)[2]);
+    suite.check("neo_hookean ∂W/∂F22", g[F22], hand_grad(p)[3]);
+    suite.check("neo_hookean ∂²W/∂F11²", derivative_of(f, wrt(F11), values(p), adpp::order<2>{}), hand_second(p));
+    suite.check("neo_hookean ∂³W/∂F11³", derivative_of(f, wrt(F11), values(p), adpp::order<3>{}), 0.0);
+
+    suite.measure("neo_hookean", "evaluate", "adpp", [&] { bench::do_not_optimize(p); return f.evaluate(values(p)); });
+    suite.measure("neo_hookean", "evaluate", "hand", [&] {
+        bench::do_not_optimize(p);
+        return neo_hookean(p[0], p[1], p[2], p[3]);
+    });
+    suite.measure("neo_hookean", "evaluate", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a11 = p[0], a12 = p[1], a21 = p[2], a22 = p[3];
+        return double(neo_hookean(a11, a12, a21, a22));
+    });
+    suite.measure("neo_hookean", "grad", "adpp", [&] { bench::do_not_optimize(p); return grad(f, values(p)); });
+    suite.measure("neo_hookean", "grad", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p); });
+    suite.measure("neo_hookean", "grad", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a11 = p[0], a12 = p[1], a21 = p[2], a22 = p[3];
+        return derivatives(neo_hookean(a11, a12, a21, a22), wrt(a11, a12, a21, a22));
+    });
+    suite.measure("neo_hookean", "derivative_of", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(F11), values(p));
+    });
+    suite.measure("neo_hookean", "derivative_of", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p)[0]; });
+    suite.measure("neo_hookean", "second_derivative", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f, wrt(F11), values(p), adpp::order<2>{});
+    });
+    suite.measure("neo_hookean", "second_derivative", "hand", [&] { bench::do_not_optimize(p); return hand_second(p); });
+}
+
+
+void lennard_jones_workload(bench::suite& suite) {
+    adpp::backward::var<double> x1;
+    adpp::backward::var<double> y1;
+    adpp::backward::var<double> x2;
+    adpp::backward::var<double> y2;
+    const auto pair = [] (const auto& r2) {
+        const auto inv6 = 1_c/(r2*r2*r2);
+        return 4_c*(inv6*inv6 - inv6);
+    };
+    const auto f = pair(x1*x1 + y1*y1) + pair(x2*x2 + y2*y2) + pair((x1 - x2)*(x1 - x2) + (y1 - y2)*(y1 - y2));
+
+    std::array p{1.1, 0.1, 0.3, 1.2};
+    const auto values = [&] (const auto& q) { return at(x1 = q[0], y1 = q[1], x2 = q[2], y2 = q[3]); };
+    const auto hand_grad = [] (const auto& q) {
+        // derivative of the pair potential w.r.t. the squared distance
+        const auto pair_derivative = [] (double r2) {
+            const double inv6 = 1.0/(r2*r2*r2);
+            return -12.0*inv6*(2.0*inv6 - 1.0)/r2;
+        };
+        const double d01 = pair_derivative(q[0]*q[0] + q[1]*q[1]);
+        const double d02 = pair_derivative(q[2]*q[2] + q[3]*q[3]);
+        const double dx = q[0] - q[2];
+        const double dy = q[1] - q[3];
+        const double d12 = pair_derivative(dx*dx + dy*dy);
+        return std::array{
+            2.0*(d01*q[0] + d12*dx),
+            2.0*(d01*q[1] + d12*dy),
+            2.0*(d02*q[2] - d12*dx),
+            2.0*(d02*q[3] - d12*dy)
+        };
+    };
+    const auto first = [&] (const auto& q) { return derivative_of(f, wrt(x1), values(q)); };
+    const auto second = [&] (const auto& q) { return derivative_of(f, wrt(x1), values(q), adpp::order<2>{}); };
+
+    const auto g = grad(f, values(p));
+    suite.check("lennard_jones value", f.evaluate(values(p)), lennard_jones(p[0], p[1], p[2], p[3]));
+    suite.check("lennard_jones ∂E/∂x1", g[x1], hand_grad(p)[0]);
+    suite.check("lennard_jones ∂E/∂y1", g[y1], hand_grad(p)[1]);
+    suite.check("lennard_jones ∂E/∂x2", g[x2], hand_grad(p)[2]);
+    suite.check("lennard_jones ∂E/∂y2", g[y2], hand_grad(p)[3]);
+    suite.check("lennard_jones ∂²E/∂x1²", second(p), bench::central_difference(first, p, 0), 1e-5);
+
+    suite.measure("lennard_jones", "evaluate", "adpp", [&] { bench::do_not_optimize(p); return f.evaluate(values(p)); });
+    suite.measure("lennard_jones", "evaluate", "hand", [&] {
+        bench::do_not_optimize(p);
+        return lennard_jones(p[0], p[1], p[2], p[3]);
+    });
+    suite.measure("lennard_jones", "evaluate", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], b1 = p[1], a2 = p[2], b2 = p[3];
+        return double(lennard_jones(a1, b1, a2, b2));
+    });
+    suite.measure("lennard_jones", "grad", "adpp", [&] { bench::do_not_optimize(p); return grad(f, values(p)); });
+    suite.measure("lennard_jones", "grad", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p); });
+    suite.measure("lennard_jones", "grad", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], b1 = p[1], a2 = p[2], b2 = p[3];
+        return derivatives(lennard_jones(a1, b1, a2, b2), wrt(a1, b1, a2, b2));
+    });
+    suite.measure("lennard_jones", "derivative_of", "adpp", [&] { bench::do_not_optimize(p); return first(p); });
+    suite.measure("lennard_jones", "derivative_of", "hand", [&] { bench::do_not_optimize(p); return hand_grad(p)[0]; });
+    suite.measure("lennard_jones", "second_derivative", "adpp", [&] { bench::do_not_optimize(p); return second(p); });
+}
+
+
+void robertson_workload(bench::suite& suite) {
+    adpp::backward::var<double> y1;
+    adpp::backward::var<double> y2;
+    adpp::backward::var<double> y3;
+    const auto f1 = 1e4_c*y2*y3 - 0.04_c*y1;
+    const auto f2 = 0.04_c*y1 - 1e4_c*y2*y3 - 3e7_c*y2*y2;
+    const auto f3 = 3e7_c*y2*y2;
+
+    std::array p{0.9, 3e-5, 0.1};
+    const auto values = [&] (const auto& q) { return at(y1 = q[0], y2 = q[1], y3 = q[2]); };
+    // the operations yield all components of the right-hand side, or the jacobian (row-major) for grad
+    const auto jacobian = [&] (const auto& q) {
+        const auto b = values(q);
+        const auto g1 = derivatives_of(f1, wrt(y1, y2, y3), b);
+        const auto g2 = derivatives_of(f2, wrt(y1, y2, y3), b);
+        const auto g3 = derivatives_of(f3, wrt(y1, y2, y3), b);
+        return std::array{g1[y1], g1[y2], g1[y3], g2[y1], g2[y2], g2[y3], g3[y1], g3[y2], g3[y3]};
+    };
+    const auto hand_jacobian = [] (const auto& q) {
+        return std::array{
+            -0.04, 1e4*q[2], 1e4*q[1],
+            0.04, -1e4*q[2] - 6e7*q[1], -1e4*q[1],
+            0.0, 6e7*q[1], 0.0
+        };
+    };
+
+    const auto rhs = robertson(p[0], p[1], p[2]);
+    const auto J = jacobian(p);
+    const auto hand_J = hand_jacobian(p);
+    suite.check("robertson f1", f1.evaluate(values(p)), rhs[0]);
+    suite.check("robertson f2", f2.evaluate(values(p)), rhs[1]);
+    suite.check("robertson f3", f3.evaluate(values(p)), rhs[2]);
+    for (std::size_t i = 0; i < J.size(); ++i)
+        suite.check("robertson jacobian", J[i], hand_J[i]);
+    suite.check("robertson ∂²f2/∂y2²", derivative_of(f2, wrt(y2), values(p), adpp::order<2>{}), -6e7);
+    suite.check("robertson ∂³f2/∂y2³", derivative_of(f2, wrt(y2), values(p), adpp::order<3>{}), 0.0);
+
+    suite.measure("robertson", "evaluate", "adpp", [&] {
+        bench::do_not_optimize(p);
+        const auto b = values(p);
+        return std::array{f1.evaluate(b), f2.evaluate(b), f3.evaluate(b)};
+    });
+    suite.measure("robertson", "evaluate", "hand", [&] { bench::do_not_optimize(p); return robertson(p[0], p[1], p[2]); });
+    suite.measure("robertson", "evaluate", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], a2 = p[1], a3 = p[2];
+        const auto r = robertson(a1, a2, a3);
+        return std::array{double(r[0]), double(r[1]), double(r[2])};
+    });
+    suite.measure("robertson", "grad", "adpp", [&] { bench::do_not_optimize(p); return jacobian(p); });
+    suite.measure("robertson", "grad", "hand", [&] { bench::do_not_optimize(p); return hand_jacobian(p); });
+    suite.measure("robertson", "grad", "autodiff", [&] {
+        bench::do_not_optimize(p);
+        const autodiff::var a1 = p[0], a2 = p[1], a3 = p[2];
+        const auto r = robertson(a1, a2, a3);
+        const auto [d11, d12, d13] = derivatives(r[0], wrt(a1, a2, a3));
+        const auto [d21, d22, d23] = derivatives(r[1], wrt(a1, a2, a3));
+        const auto [d31, d32, d33] = derivatives(r[2], wrt(a1, a2, a3));
+        return std::array{d11, d12, d13, d21, d22, d23, d31, d32, d33};
+    });
+    suite.measure("robertson", "derivative_of", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f2, wrt(y2), values(p));
+    });
+    suite.measure("robertson", "derivative_of", "hand", [&] {
+        bench::do_not_optimize(p);
+        return -1e4*p[2] - 6e7*p[1];
+    });
+    suite.measure("robertson", "second_derivative", "adpp", [&] {
+        bench::do_not_optimize(p);
+        return derivative_of(f2, wrt(y2), values(p), adpp::order<2>{});
+    });
+}
+
+
+int main(int argc, char** argv) {
+    const auto options = bench::options::from_args(argc, argv);
+    bench::suite suite{options};
+    rosenbrock_workload(suite);
+    mlp_workload(suite);
+    neo_hookean_workload(suite);
+    lennard_jones_workload(suite);
+    robertson_workload(suite);
+
+    if (!options.output.empty()) {
+        std::ofstream file{options.output};
+        if (!file)
+            throw std::runtime_error("Could not open " + options.output);
+        suite.write_json(file);
+    }
+    return 0;
+}
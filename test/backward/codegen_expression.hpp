@@ -0,0 +1,4 @@
+#pragma once
+
+// expression with shared sub-expressions, used by the generator and the test of the generated kernel
+#define CODEGEN_EXPRESSION(x, y, mu) exp((x + y/x)*mu)*(x*y) + (x*y)/(cval<2> - mu) - cval<3>*x
@@ -0,0 +1,24 @@
+#include <stdexcept>
+#include <fstream>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/codegen.hpp>
+
+#include "codegen_expression.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        throw std::runtime_error("Expected the paths of the source and header files to be written");
+
+    using namespace adpp::backward;
+    var x;
+    var y;
+    let mu;
+    std::ofstream source{argv[1]};
+    std::ofstream header{argv[2]};
+    write_kernel_source(source, "codegen_kernel", CODEGEN_EXPRESSION(x, y, mu), wrt(x, y, mu));
+    write_kernel_header(header, "codegen_kernel");
+    return 0;
+}
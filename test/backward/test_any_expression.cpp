@@ -0,0 +1,129 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <string>
+#include <sstream>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/any_expression.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::throws;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::function;
+using adpp::backward::any_expression;
+
+int main() {
+
+    "any_expression_heterogeneous_container"_test = [] () {
+        var x;
+        var y;
+        let a;
+        let b;
+        using expression_t = any_expression<double, decltype(x), decltype(y)>;
+
+        std::vector<expression_t> residuals;
+        residuals.emplace_back(x*y);
+        residuals.emplace_back(function{exp(x) - y});
+        residuals.emplace_back((a*x + b*y).with(a = 2.0, b = 3.0));
+
+        const auto values = at(x = 1.5, y = 2.0);
+        expect(eq(residuals[0](values), 3.0));
+        expect(eq(residuals[1](values), std::exp(1.5) - 2.0));
+        expect(eq(residuals[2](values), 9.0));
+
+        const auto [value, derivs] = residuals[2].value_and_grad(values);
+        expect(eq(value, 9.0));
+        expect(eq(derivs[x], 2.0));
+        expect(eq(derivs[y], 3.0));
+        expect(eq(residuals[1].grad(values)[x], std::exp(1.5)));
+        expect(eq(residuals[1].grad(values)[y], -1.0));
+    };
+
+    "any_expression_batch"_test = [] () {
+        var x;
+        var y;
+        const auto expression = exp(x*y)/(x + y);
+        any_expression<double, decltype(x), decltype(y)> erased{expression};
+
+        const std::vector points{0.5, 1.0, 1.0, 2.0, 2.0, 0.25};
+        std::vector<double> values(3);
+        std::vector<double> gradients(6);
+        erased.evaluate(points, values);
+        for (std::size_t p = 0; p < 3; ++p)
+            expect(eq(values[p], evaluate(expression, at(x = points[2*p], y = points[2*p + 1]))));
+
+        erased.value_and_grad(points, values, gradients);
+        for (std::size_t p = 0; p < 3; ++p) {
+            const auto reference = grad(expression, at(x = points[2*p], y = points[2*p + 1]));
+            expect(approx(gradients[2*p], reference[x], 1e-12));
+            expect(approx(gradients[2*p + 1], reference[y], 1e-12));
+        }
+
+        std::vector<double> too_small(2);
+        expect(throws([&] () { erased.evaluate(points, too_small); }));
+        expect(throws([&] () { erased.evaluate(std::vector{1.0, 2.0, 3.0}, values); }));
+        expect(throws([&] () { erased.value_and_grad(points, values, too_small); }));
+    };
+
+    "any_expression_copy_and_move"_test = [] () {
+        var x;
+        let a;
+        let b;
+        let c;
+        let d;
+        let e;
+        let f;
+        let g;
+        // this one is too large for the small buffer
+        const auto large = (a*x + b*x + c*x + d*x + e*x + f*x + g*x).with(
+            a = 1.0, b = 2.0, c = 3.0, d = 4.0, e = 5.0, f = 6.0, g = 7.0
+        );
+        using expression_t = any_expression<double, decltype(x)>;
+        for (expression_t original : {expression_t{x*x}, expression_t{large}}) {
+            const double expected = original(at(x = 2.0));
+            expression_t copy{original};
+            expression_t moved{std::move(original)};
+            expect(!original);
+            expect(eq(copy(at(x = 2.0)), expected));
+            expect(eq(moved(at(x = 2.0)), expected));
+
+            original = copy;
+            copy = std::move(moved);
+            expect(!moved);
+            expect(eq(original(at(x = 2.0)), expected));
+            expect(eq(copy(at(x = 2.0)), expected));
+        }
+
+        expression_t empty;
+        expect(!empty);
+        expect(throws([&] () { empty(at(x = 1.0)); }));
+    };
+
+    "any_expression_export"_test = [] () {
+        var x;
+        var y;
+        let a;
+        using expression_t = any_expression<double, decltype(x), decltype(y)>;
+        std::ostringstream s;
+        expression_t{exp((x + y/x)*y)}.export_to(s, at(x = "x", y = "y"));
+        expect(eq(s.str(), std::string{"exp((x + y/x)*y)"}));
+
+        std::ostringstream bound;
+        expression_t{(a*x + y).with(a = 2.0)}.export_to(bound, at(x = "x", y = "y"));
+        expect(eq(bound.str(), std::string{"2*x + y"}));
+    };
+
+    return EXIT_SUCCESS;
+}
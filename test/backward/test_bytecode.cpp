@@ -0,0 +1,142 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/bytecode.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::throws;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::wrt;
+using adpp::backward::opcode;
+using adpp::backward::bytecode;
+using adpp::backward::instruction;
+using adpp::backward::to_bytecode;
+
+int main() {
+
+    "bytecode_instructions"_test = [] () {
+        var a;
+        var b;
+        using expression_t = decltype(a*b + exp(a*b));
+        constexpr auto instructions = adpp::backward::bytecode_instructions_v<expression_t>;
+        // a, b, a*b, exp(a*b) and the sum
+        static_assert(instructions.size() == 5);
+        static_assert(instructions[0].code == opcode::input);
+        static_assert(instructions[1].code == opcode::input);
+        static_assert(instructions[2].code == opcode::multiply);
+        static_assert(instructions[3].code == opcode::exp && instructions[3].lhs == 2);
+        static_assert(instructions[4].code == opcode::add && instructions[4].lhs == 2 && instructions[4].rhs == 3);
+    };
+
+    "bytecode_evaluate_and_grad"_test = [] () {
+        var a;
+        var b;
+        let mu;
+        const auto expression = a*b + exp(a)/b - a*mu*2.0;
+
+        auto code = to_bytecode(expression, wrt(a, b, mu));
+        expect(eq(code.num_inputs(), std::size_t{3}));
+        expect(eq(code.constants().size(), std::size_t{1}));
+
+        std::array<double, 3> gradient;
+        for (double v : {0.5, 1.0, 2.0}) {
+            const auto values = at(a = v, b = 3.0*v, mu = 0.5);
+            const auto reference = grad(expression, values);
+            const std::array inputs{v, 3.0*v, 0.5};
+            expect(eq(code.evaluate(inputs), evaluate(expression, values)));
+            expect(eq(code.value_and_grad(inputs, gradient), evaluate(expression, values)));
+            expect(approx(gradient[0], reference[a], 1e-9));
+            expect(approx(gradient[1], reference[b], 1e-9));
+            expect(approx(gradient[2], -2.0*v, 1e-9));
+        }
+    };
+
+    "bytecode_shares_common_subexpressions"_test = [] () {
+        var a;
+        var b;
+        auto code = to_bytecode(a*b*(a*b) + a*b, wrt(a, b));
+        // a, b, a*b, the product and the sum
+        expect(eq(code.size(), std::size_t{5}));
+
+        std::array<double, 2> gradient;
+        expect(eq(code.value_and_grad(std::array{2.0, 3.0}, gradient), 42.0));
+        expect(approx(gradient[0], 2.0*6.0*3.0 + 3.0, 1e-9));
+        expect(approx(gradient[1], 2.0*6.0*2.0 + 2.0, 1e-9));
+    };
+
+    "bytecode_binary_roundtrip"_test = [] () {
+        var a;
+        var b;
+        const auto expression = exp(a)*b - 3.0/a;
+
+        std::stringstream stream;
+        to_bytecode(expression, wrt(a, b)).write(stream);
+        auto code = bytecode<>::read(stream);
+
+        std::array<double, 2> gradient;
+        const auto values = at(a = 1.5, b = 2.0);
+        const auto reference = grad(expression, values);
+        expect(eq(code.value_and_grad(std::array{1.5, 2.0}, gradient), evaluate(expression, values)));
+        expect(approx(gradient[0], reference[a], 1e-9));
+        expect(approx(gradient[1], reference[b], 1e-9));
+    };
+
+    "bytecode_non_finite_partials"_test = [] () {
+        var a;
+        var b;
+        let mu;
+        const auto expression = b*(a*mu);
+
+        // the adjoint of a*mu is zero, which still has to be multiplied with the infinite partial
+        auto code = to_bytecode(expression, wrt(a, b, mu));
+        std::array<double, 3> gradient;
+        const std::array inputs{1.0, 0.0, std::numeric_limits<double>::infinity()};
+        code.value_and_grad(inputs, gradient);
+        const auto reference = grad(expression, at(a = inputs[0], b = inputs[1], mu = inputs[2]));
+        expect(std::isnan(gradient[0]) and std::isnan(reference[a]));
+    };
+
+    "bytecode_invalid_arguments"_test = [] () {
+        expect(throws([] () { bytecode<>{{}, {}, 0}; }));
+        expect(throws([] () { bytecode<>{{instruction{opcode::input, 1, 0}}, {}, 1}; }));
+        expect(throws([] () { bytecode<>{{instruction{opcode::constant, 0, 0}}, {}, 0}; }));
+        expect(throws([] () { bytecode<>{{instruction{opcode::input, 0, 0}, instruction{opcode::add, 0, 1}}, {}, 1}; }));
+        expect(throws([] () { bytecode<>{{instruction{opcode::preaccumulated, 0, 0}}, {}, 0}; }));
+
+        std::stringstream garbage{"not bytecode"};
+        expect(throws([&] () { bytecode<>::read(garbage); }));
+
+        var a;
+        auto code = to_bytecode(a*a, wrt(a));
+        std::stringstream truncated;
+        code.write(truncated);
+        std::stringstream partial{truncated.str().substr(0, 20)};
+        expect(throws([&] () { bytecode<>::read(partial); }));
+        expect(throws([&] () { code.evaluate(std::array{1.0, 2.0}); }));
+
+        // huge counts in a corrupt header must not be allocated up front
+        std::stringstream corrupt;
+        corrupt.write(bytecode<>::magic.data(), bytecode<>::magic.size());
+        for (const std::uint32_t value : {bytecode<>::version, std::uint32_t{sizeof(double)}, 1u, 0xffffffffu, 0xffffffffu})
+            corrupt.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        expect(throws<std::invalid_argument>([&] () { bytecode<>::read(corrupt); }));
+    };
+
+    return EXIT_SUCCESS;
+}
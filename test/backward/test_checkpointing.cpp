@@ -0,0 +1,99 @@
+#include <cstdlib>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <array>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/checkpointing.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::time_stepper;
+
+int main() {
+
+    "time_stepper_step"_test = [] () {
+        var x;
+        var v;
+        let dt;
+        time_stepper stepper{bind(x = x + dt*v, v = v - dt*x), at(dt = 0.5), 2};
+        const auto next = stepper.step({1.0, 2.0});
+        expect(eq(next[0], 2.0));
+        expect(eq(next[1], 1.5));
+        expect(eq(stepper.integrate({1.0, 2.0}, 2)[0], 2.75));
+    };
+
+    "time_stepper_adjoint_step"_test = [] () {
+        var x;
+        var v;
+        time_stepper stepper{bind(x = x*v, v = exp(x)), 0};
+        const auto adjoint = stepper.adjoint_step({1.0, 2.0}, {1.0, 0.5});
+        expect(eq(adjoint[0], 2.0 + 0.5*std::exp(1.0)));
+        expect(eq(adjoint[1], 1.0));
+    };
+
+    "time_stepper_reverse_is_independent_of_checkpoints"_test = [] () {
+        var x;
+        var v;
+        let dt;
+        const auto step = bind(x = x + dt*v, v = v - dt*x*x*x);
+        constexpr std::size_t steps = 50;
+
+        // reference: store all states and reverse them
+        time_stepper reference{step, at(dt = 0.01), 0};
+        std::vector<std::array<double, 2>> states{{1.0, 0.0}};
+        for (std::size_t i = 0; i < steps; ++i)
+            states.push_back(reference.step(states.back()));
+        std::array adjoint{1.0, 0.0};
+        for (std::size_t i = steps; i > 0; --i)
+            adjoint = reference.adjoint_step(states[i-1], adjoint);
+
+        for (std::size_t checkpoints : {0, 1, 2, 3, 5, 100}) {
+            time_stepper stepper{step, at(dt = 0.01), checkpoints};
+            const auto [final_state, initial_adjoint] = stepper.reverse(
+                {1.0, 0.0}, steps, [] (const auto&) { return std::array{1.0, 0.0}; }
+            );
+            expect(eq(final_state[0], states.back()[0]));
+            expect(eq(final_state[1], states.back()[1]));
+            expect(eq(initial_adjoint[0], adjoint[0]));
+            expect(eq(initial_adjoint[1], adjoint[1]));
+            expect(eq(stepper.statistics().adjoint_steps, steps));
+            expect(stepper.statistics().max_checkpoints <= checkpoints);
+        }
+    };
+
+    "time_stepper_recomputation_decreases_with_checkpoints"_test = [] () {
+        var x;
+        let dt;
+        constexpr std::size_t steps = 100;
+        time_stepper no_checkpoints{bind(x = x - dt*x), at(dt = 0.1), 0};
+        time_stepper few_checkpoints{bind(x = x - dt*x), at(dt = 0.1), 4};
+        const auto seed = [] (const auto&) { return std::array{1.0}; };
+        no_checkpoints.reverse({1.0}, steps, seed);
+        few_checkpoints.reverse({1.0}, steps, seed);
+        expect(eq(no_checkpoints.statistics().forward_steps, steps*(steps - 1)/2 + 1));
+        expect(few_checkpoints.statistics().forward_steps < 4*steps);
+    };
+
+    "time_stepper_value_and_grad"_test = [] () {
+        var x;
+        let dt;
+        time_stepper stepper{bind(x = x - dt*x), at(dt = 0.1), 3};
+        const auto [value, gradient] = stepper.value_and_grad(x*x, {2.0}, 10);
+        const double factor = std::pow(0.9, 10);
+        expect(std::abs(value - 4.0*factor*factor) < 1e-12);
+        expect(std::abs(gradient[0] - 4.0*factor*factor) < 1e-12);
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <string>
+#include <sstream>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/codegen.hpp>
+
+#include "codegen_expression.hpp"
+#include "codegen_kernel.hpp"
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::throws;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::cval;
+using adpp::backward::wrt;
+using adpp::backward::to_bytecode;
+using adpp::backward::write_kernel_source;
+using adpp::backward::write_kernel_header;
+
+int main() {
+
+    "generated_kernel"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expression = CODEGEN_EXPRESSION(x, y, mu);
+
+        std::array<double, 3> gradient;
+        for (double v : {0.5, 1.0, 2.0}) {
+            const auto values = at(x = v, y = 3.0*v, mu = 0.25);
+            const auto reference = grad(expression, values);
+            const std::array inputs{v, 3.0*v, 0.25};
+            expect(approx(codegen_kernel(inputs.data()), evaluate(expression, values), 1e-12));
+            expect(approx(codegen_kernel_gradient(inputs.data(), gradient.data()), evaluate(expression, values), 1e-12));
+            expect(approx(gradient[0], reference[x], 1e-9));
+            expect(approx(gradient[1], reference[y], 1e-9));
+        }
+    };
+
+    "generated_source"_test = [] () {
+        var x;
+        var y;
+        std::ostringstream s;
+        write_kernel_source(s, "f", (x*y)*(x*y) + cval<2>, wrt(x, y));
+        const std::string expected =
+            "// Generated by adpp, do not edit\n"
+            "#include <cmath>\n"
+            "\n"
+            "double f(const double* input) {\n"
+            "    const double t0 = input[0];\n"
+            "    const double t1 = input[1];\n"
+            "    const double t2 = 2;\n"
+            "    const double t3 = t0*t1;\n"
+            "    const double t4 = t3*t3;\n"
+            "    const double t5 = t4 + t2;\n"
+            "    return t5;\n"
+            "}\n"
+            "\n"
+            "double f_gradient(const double* input, double* gradient) {\n"
+            "    const double t0 = input[0];\n"
+            "    const double t1 = input[1];\n"
+            "    const double t2 = 2;\n"
+            "    const double t3 = t0*t1;\n"
+            "    const double t4 = t3*t3;\n"
+            "    const double t5 = t4 + t2;\n"
+            "    gradient[0] = 0;\n"
+            "    gradient[1] = 0;\n"
+            "    double a0 = 0;\n"
+            "    double a1 = 0;\n"
+            "    double a3 = 0;\n"
+            "    double a4 = 0;\n"
+            "    double a5 = 1;\n"
+            "    a4 += a5;\n"
+            "    a3 += a4*t3;\n"
+            "    a3 += a4*t3;\n"
+            "    a0 += a3*t1;\n"
+            "    a1 += a3*t0;\n"
+            "    gradient[1] += a1;\n"
+            "    gradient[0] += a0;\n"
+            "    return t5;\n"
+            "}\n";
+        expect(eq(s.str(), expected));
+
+        std::ostringstream h;
+        write_kernel_header(h, "f");
+        expect(eq(h.str(), std::string{
+            "// Generated by adpp, do not edit\n"
+            "#pragma once\n"
+            "\n"
+            "double f(const double* input);\n"
+            "double f_gradient(const double* input, double* gradient);\n"
+        }));
+    };
+
+    "generated_literals"_test = [] () {
+        using adpp::backward::detail::cpp_literal;
+        expect(eq(cpp_literal(2.0), std::string{"2"}));
+        expect(eq(cpp_literal(0.5), std::string{"0.5"}));
+        expect(eq(cpp_literal(2.0f), std::string{"2.0f"}));
+        expect(eq(cpp_literal(0.5f), std::string{"0.5f"}));
+        expect(eq(cpp_literal(-3.0L), std::string{"-3.0L"}));
+        expect(eq(cpp_literal(1e30L), std::string{"1e+30L"}));
+    };
+
+    "generated_source_invalid_arguments"_test = [] () {
+        var x;
+        std::ostringstream s;
+        expect(throws([&] () { write_kernel_source(s, "not a name", x*x, wrt(x)); }));
+        expect(throws([&] () { write_kernel_header(s, "1f"); }));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,7 @@
 #include <cstdlib>
+#include <cmath>
+#include <array>
+#include <span>
 
 #include <boost/ut.hpp>
 
@@ -24,6 +27,17 @@ struct expression_type<adpp::backward::bound_expression<E, B>> : std::type_ident
 template<typename E, typename B>
 struct bindings_type<adpp::backward::bound_expression<E, B>> : std::type_identity<B> {};
 
+// mimics the interface of Eigen::Map with an inner stride
+struct strided_map {
+    double* ptr;
+    long n;
+    long stride;
+
+    double* data() const { return ptr; }
+    long size() const { return n; }
+    long innerStride() const { return stride; }
+};
+
 int main() {
 
     "derivatives"_test = [] () {
@@ -209,6 +223,47 @@ int main() {
         }
     };
 
+    "gradient_into_buffer"_test = [] () {
+        var x;
+        var y;
+        var z;
+        const auto expr = x*y + z*z;
+        std::array<double, 3> out;
+        grad_into(expr, at(x = 1.0, y = 2.0, z = 3.0), wrt(z, x, y), std::span<double>{out});
+        expect(eq(out[0], 6.0));
+        expect(eq(out[1], 2.0));
+        expect(eq(out[2], 1.0));
+    };
+
+    "gradient_into_strided_view"_test = [] () {
+        var x;
+        var y;
+        const auto expr = x*y;
+        std::array<double, 4> out{0.0, 0.0, 0.0, 0.0};
+        grad_into(expr, at(x = 2.0, y = 3.0), wrt(x, y), strided_map{out.data(), 2, 2});
+        expect(eq(out[0], 3.0));
+        expect(eq(out[1], 0.0));
+        expect(eq(out[2], 2.0));
+        expect(eq(out[3], 0.0));
+    };
+
+    "gradient_into_jacobian"_test = [] () {
+        var x;
+        var y;
+        const auto expr = x*x*y;
+        std::array<double, 4> row_major;
+        std::array<double, 4> col_major;
+        for (std::size_t row = 0; row < 2; ++row) {
+            const auto values = at(x = 1.0 + row, y = 3.0);
+            jacobian_row_into(expr, values, wrt(x, y), row_major, row, 2, adpp::row_major_layout);
+            jacobian_row_into(expr, values, wrt(x, y), col_major, row, 2, adpp::column_major_layout);
+        }
+        expect(eq(row_major[0], 6.0)); expect(eq(row_major[1], 1.0));
+        expect(eq(row_major[2], 12.0)); expect(eq(row_major[3], 4.0));
+        expect(eq(col_major[0], 6.0)); expect(eq(col_major[2], 1.0));
+        expect(eq(col_major[1], 12.0)); expect(eq(col_major[3], 4.0));
+    };
+
     "bound_expression_back_propagate"_test = [] () {
         static constexpr var a;
         static constexpr let b;
@@ -268,5 +323,87 @@ int main() {
         expect(eq(derivative.evaluate(), 8.0));
     };
 
+    "gradient_expression_evaluate"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expression = exp(x*y)*(x + y*mu);
+        const auto gradient = differentiate(expression, wrt(x, y));
+        static_assert(decltype(gradient)::size == 2);
+
+        const auto values = at(x = 0.5, y = 1.5, mu = 2.0);
+        const auto reference = grad(expression, values);
+        const auto result = gradient.evaluate(values);
+        expect(eq(result[x], reference[x]));
+        expect(eq(result[y], reference[y]));
+        expect(eq(evaluate(gradient[x], values), reference[x]));
+        expect(eq(evaluate(gradient[y], values), reference[y]));
+    };
+
+    "gradient_expression_evaluates_shared_nodes_once"_test = [] () {
+        var x;
+        var y;
+        const auto expression = exp(x*y);
+        const auto gradient = differentiate(expression, wrt(x, y));
+        // x*y, exp(x*y), 1*y, x*1 and the two products; the first two are shared by both components
+        static_assert(decltype(gradient)::node_count == 6);
+        expect(eq(gradient.evaluate(at(x = 1.0, y = 2.0))[x], 2.0*std::exp(2.0)));
+    };
+
+    "gradient_expression_differentiate_again"_test = [] () {
+        static constexpr var x;
+        static constexpr var y;
+        constexpr auto hessian_column = differentiate(x*x*y, wrt(x, y)).differentiate(wrt(x));
+        constexpr auto derivs = hessian_column.evaluate(at(x = 3.0, y = 2.0));
+        static_assert(derivs[x] == 2.0*2.0);
+        static_assert(derivs[y] == 2.0*3.0);
+    };
+
+    "bound_expression_with_intermediate_back_propagate"_test = [] () {
+        var x;
+        var y;
+        var z;
+        let t;
+        const auto formula = (t*t + exp(t)).with(t = x*y + z);
+        const auto [value, derivs] = formula.template back_propagate<double>(at(x = 1.0, y = 2.0, z = -1.0), wrt(x, y, z));
+        const double tv = 1.0;
+        const double dt = 2.0*tv + std::exp(tv);
+        expect(eq(value, tv*tv + std::exp(tv)));
+        expect(eq(derivs[x], dt*2.0));
+        expect(eq(derivs[y], dt*1.0));
+        expect(eq(derivs[z], dt));
+
+        const auto gradient = grad(formula, at(x = 1.0, y = 2.0, z = -1.0));
+        expect(eq(gradient[x], dt*2.0));
+        expect(eq(gradient[z], dt));
+    };
+
+    "bound_expression_with_intermediate_higher_order_derivative"_test = [] () {
+        var x;
+        var y;
+        var z;
+        let t;
+        const auto formula = (t*t + exp(t)).with(t = x*y + z);
+        const auto values = at(x = 1.0, y = 2.0, z = -1.0);
+        const double tv = 1.0;
+
+        // the intermediate is substituted before differentiating symbolically
+        const auto df_dx = formula.differentiate(wrt(x));
+        expect(eq(df_dx.evaluate(values), (2.0*tv + std::exp(tv))*2.0));
+        expect(eq(derivative_of(formula, wrt(x), values, adpp::second_order), (2.0 + std::exp(tv))*2.0*2.0));
+        expect(eq(derivative_of(formula, wrt(z), values, adpp::second_order), 2.0 + std::exp(tv)));
+        expect(eq(derivative_of(formula, wrt(x), values, adpp::third_order), std::exp(tv)*2.0*2.0*2.0));
+    };
+
+    "bound_expression_with_mixed_bindings_back_propagate"_test = [] () {
+        var x;
+        let mu;
+        let t;
+        const auto formula = (t*mu + x).with(mu = 3.0, t = x*x);
+        const auto [value, derivs] = formula.template back_propagate<double>(at(x = 2.0), wrt(x));
+        expect(eq(value, 14.0));
+        expect(eq(derivs[x], 3.0*2.0*2.0 + 1.0));
+    };
+
     return EXIT_SUCCESS;
 }
@@ -138,5 +138,14 @@ int main() {
         expect(eq(formula.evaluate(), 12.0));
     };
 
+    "bound_expression_with_intermediate_evaluate"_test = [] () {
+        static constexpr var x;
+        static constexpr var y;
+        static constexpr let t;
+        constexpr auto formula = (t*t + t).with(t = x*y + cval<1>);
+        static_assert(formula.evaluate(at(x = 2.0, y = 3.0)) == 49.0 + 7.0);
+        expect(eq(formula(x = 1.0, y = 1.0), 4.0 + 2.0));
+    };
+
     return EXIT_SUCCESS;
 }
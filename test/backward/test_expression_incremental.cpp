@@ -0,0 +1,84 @@
+#include <cstdlib>
+#include <cmath>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/incremental.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::cval;
+using adpp::backward::incremental_evaluator;
+
+int main() {
+
+    "incremental_evaluate"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expr = exp(x*mu) + y*y*mu;
+        incremental_evaluator evaluator{expr, at(x = 1.0, y = 2.0, mu = 0.5)};
+        static_assert(decltype(evaluator)::size() == 5);
+
+        expect(eq(evaluator.evaluate(), evaluate(expr, at(x = 1.0, y = 2.0, mu = 0.5))));
+        expect(eq(evaluator.evaluations(), std::size_t{5}));
+
+        evaluator.set(y = 3.0);
+        expect(eq(evaluator.evaluate(), evaluate(expr, at(x = 1.0, y = 3.0, mu = 0.5))));
+        expect(eq(evaluator.evaluations(), std::size_t{3}));
+
+        evaluator.set(y = 3.0);
+        expect(eq(evaluator.evaluate(), evaluate(expr, at(x = 1.0, y = 3.0, mu = 0.5))));
+        expect(eq(evaluator.evaluations(), std::size_t{0}));
+
+        evaluator.set(at(x = 2.0));
+        expect(eq(evaluator.evaluate(), evaluate(expr, at(x = 2.0, y = 3.0, mu = 0.5))));
+        expect(eq(evaluator.evaluations(), std::size_t{3}));
+    };
+
+    "incremental_gradient"_test = [] () {
+        var x;
+        var y;
+        const auto expr = exp(x*cval<2>)*y + y/x;
+        incremental_evaluator evaluator{expr, at(x = 1.0, y = 2.0)};
+
+        const auto check = [&] (double xv, double yv) {
+            const auto expected = grad(expr, at(x = xv, y = yv));
+            const auto& gradient = evaluator.grad();
+            expect(eq(gradient[x], expected[x]));
+            expect(eq(gradient[y], expected[y]));
+        };
+
+        check(1.0, 2.0);
+        evaluator.set(y = 4.0);
+        check(1.0, 4.0);
+        expect(eq(evaluator.evaluations(), std::size_t{3}));
+
+        evaluator.set(x = 0.5);
+        check(0.5, 4.0);
+        const auto [value, gradient] = evaluator.value_and_grad();
+        expect(eq(value, evaluate(expr, at(x = 0.5, y = 4.0))));
+        expect(eq(evaluator.evaluations(), std::size_t{0}));
+    };
+
+    "incremental_shared_subexpressions"_test = [] () {
+        var x;
+        var y;
+        const auto tmp = x*y;
+        const auto expr = tmp*tmp + tmp;
+        incremental_evaluator evaluator{expr, at(x = 2.0, y = 3.0)};
+        static_assert(decltype(evaluator)::size() == 3);
+        expect(eq(evaluator.evaluate(), 6.0*6.0 + 6.0));
+        expect(eq(evaluator.grad()[x], 2.0*6.0*3.0 + 3.0));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <sstream>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/linalg.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::cval;
+using adpp::dtype::vector;
+using adpp::dtype::matrix;
+
+int main() {
+
+    "dot_evaluate"_test = [] () {
+        static constexpr var<vector<5>> a;
+        static constexpr var<vector<5>> b;
+        static constexpr std::array va{1.0, 2.0, 3.0, 4.0, 5.0};
+        static constexpr std::array vb{2.0, 3.0, 4.0, 5.0, 6.0};
+        static_assert(evaluate(dot(a, b), at(a = va, b = vb)) == 2.0 + 6.0 + 12.0 + 20.0 + 30.0);
+    };
+
+    "dot_gradient"_test = [] () {
+        var<vector<5>> a;
+        var<vector<5>> b;
+        const std::array va{1.0, 2.0, 3.0, 4.0, 5.0};
+        const std::array vb{2.0, 3.0, 4.0, 5.0, 6.0};
+        const auto gradient = grad(dot(a, b)*cval<2>, at(a = va, b = vb));
+        for (std::size_t i = 0; i < 5; ++i) {
+            expect(eq(gradient[a][i], 2.0*vb[i]));
+            expect(eq(gradient[b][i], 2.0*va[i]));
+        }
+    };
+
+    "dot_gradient_mixed_with_scalars"_test = [] () {
+        var<vector<2>> w;
+        let<vector<2>> x;
+        var bias;
+        const auto expression = exp(dot(w, x) + bias);
+        const std::array vw{0.5, -1.0};
+        const std::array vx{2.0, 1.0};
+        const auto gradient = grad(expression, at(w = vw, x = vx, bias = 0.5));
+        const double value = std::exp(0.5*2.0 - 1.0 + 0.5);
+        expect(eq(gradient[bias], value));
+        expect(eq(gradient[w][0], value*vx[0]));
+        expect(eq(gradient[w][1], value*vx[1]));
+    };
+
+    "matvec_evaluate"_test = [] () {
+        static constexpr var<matrix<2, 3>> A;
+        static constexpr var<vector<3>> x;
+        static constexpr std::array<std::array<double, 3>, 2> vA{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}};
+        static constexpr std::array vx{1.0, 0.0, -1.0};
+        constexpr auto result = evaluate(matvec(A, x), at(A = vA, x = vx));
+        static_assert(result[0] == -2.0);
+        static_assert(result[1] == -2.0);
+    };
+
+    "dot_of_matvec_gradient"_test = [] () {
+        var<vector<2>> y;
+        var<matrix<2, 3>> A;
+        var<vector<3>> x;
+        const std::array vy{1.0, 2.0};
+        const std::array<std::array<double, 3>, 2> vA{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}};
+        const std::array vx{1.0, 0.0, -1.0};
+        const auto gradient = grad(dot(y, matvec(A, x)), at(y = vy, A = vA, x = vx));
+
+        // ∂/∂y = Ax, ∂/∂x = Aᵀy, ∂/∂A = y xᵀ
+        expect(eq(gradient[y][0], -2.0));
+        expect(eq(gradient[y][1], -2.0));
+        for (std::size_t j = 0; j < 3; ++j)
+            expect(eq(gradient[x][j], vA[0][j]*vy[0] + vA[1][j]*vy[1]));
+        for (std::size_t i = 0; i < 2; ++i)
+            for (std::size_t j = 0; j < 3; ++j)
+                expect(eq(gradient[A][i*3 + j], vy[i]*vx[j]));
+    };
+
+    "norm2_gradient"_test = [] () {
+        var<vector<2>> x;
+        const std::array vx{3.0, 4.0};
+        const auto [value, derivs] = norm2(x).template back_propagate<double>(at(x = vx), wrt(x));
+        expect(eq(value, 5.0));
+        expect(eq(derivs[x][0], 3.0/5.0));
+        expect(eq(derivs[x][1], 4.0/5.0));
+    };
+
+    "norm2_gradient_at_zero"_test = [] () {
+        var<vector<2>> x;
+        const std::array vx{0.0, 0.0};
+        const auto [value, derivs] = norm2(x).template back_propagate<double>(at(x = vx), wrt(x));
+        expect(eq(value, 0.0));
+        expect(eq(derivs[x][0], 0.0));
+        expect(eq(derivs[x][1], 0.0));
+    };
+
+    "quad_gradient"_test = [] () {
+        var<vector<2>> x;
+        var<matrix<2, 2>> A;
+        const std::array vx{1.0, 2.0};
+        const std::array<std::array<double, 2>, 2> vA{{{1.0, 2.0}, {3.0, 4.0}}};
+        const auto gradient = grad(quad(x, A), at(x = vx, A = vA));
+        expect(eq(evaluate(quad(x, A), at(x = vx, A = vA)), 1.0*5.0 + 2.0*11.0));
+
+        // ∂/∂x = (A + Aᵀ)x, ∂/∂A = x xᵀ
+        expect(eq(gradient[x][0], 2.0*1.0 + 5.0*2.0));
+        expect(eq(gradient[x][1], 5.0*1.0 + 8.0*2.0));
+        expect(eq(gradient[A][0], 1.0));
+        expect(eq(gradient[A][1], 2.0));
+        expect(eq(gradient[A][2], 2.0));
+        expect(eq(gradient[A][3], 4.0));
+    };
+
+    "linalg_derivative_of_independent_var"_test = [] () {
+        static constexpr var<vector<2>> x;
+        static constexpr var y;
+        constexpr auto derivative = differentiate(norm2(x)*y, wrt(y));
+        static_assert(evaluate(derivative, at(x = std::array{3.0, 4.0}, y = 1.0)) == 5.0);
+    };
+
+    "linalg_stream"_test = [] () {
+        let a;
+        let M;
+        std::ostringstream s;
+        s << (dot(a, matvec(M, a)) + norm2(a)*quad(a, M)).with(a = "a", M = "M");
+        expect(eq(s.str(), std::string{"dot(a, matvec(M, a)) + (norm2(a))*(quad(a, M))"}));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <cmath>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/memoize.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::function;
+using adpp::backward::memoized;
+
+int main() {
+
+    "memoized_evaluate"_test = [] () {
+        var x;
+        var y;
+        const memoized f{function{exp(x*y) + y}};
+        expect(eq(f(x = 1.0, y = 2.0), std::exp(2.0) + 2.0));
+        expect(eq(f.hits(), std::size_t{0}));
+        expect(eq(f.misses(), std::size_t{1}));
+
+        expect(eq(f(at(x = 1.0, y = 2.0)), std::exp(2.0) + 2.0));
+        expect(eq(f.hits(), std::size_t{1}));
+        expect(eq(f(x = 2.0, y = 2.0), std::exp(4.0) + 2.0));
+        expect(eq(f.misses(), std::size_t{2}));
+        expect(eq(f.hit_rate(), 1.0/3.0));
+    };
+
+    "memoized_value_and_grad"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expression = x*x*mu + y;
+        const memoized f{expression};
+        const auto [value, derivs] = f.value_and_grad(at(x = 3.0, y = 1.0, mu = 2.0));
+        expect(eq(value, 19.0));
+        expect(eq(derivs[x], 12.0));
+        expect(eq(derivs[y], 1.0));
+        expect(eq(f.misses(), std::size_t{1}));
+
+        const auto [cached_value, cached_derivs] = f.value_and_grad(at(x = 3.0, y = 1.0, mu = 2.0));
+        expect(eq(cached_value, 19.0));
+        expect(eq(cached_derivs[x], 12.0));
+        expect(eq(f.hits(), std::size_t{1}));
+
+        // changing a let-bound value must not hit the cache
+        const auto [other_value, other_derivs] = f.value_and_grad(at(x = 3.0, y = 1.0, mu = 1.0));
+        expect(eq(other_value, 10.0));
+        expect(eq(other_derivs[x], 6.0));
+        expect(eq(f.misses(), std::size_t{2}));
+    };
+
+    "memoized_value_does_not_provide_gradient"_test = [] () {
+        var x;
+        const memoized f{x*x};
+        expect(eq(f(x = 2.0), 4.0));
+        const auto [value, derivs] = f.value_and_grad(at(x = 2.0));
+        expect(eq(derivs[x], 4.0));
+        expect(eq(f.misses(), std::size_t{2}));
+        expect(eq(f(x = 2.0), 4.0));
+        expect(eq(f.hits(), std::size_t{1}));
+    };
+
+    "memoized_bounded_capacity"_test = [] () {
+        var x;
+        memoized f{x*x, 16};
+        for (int i = 0; i < 1000; ++i)
+            expect(eq(f(x = static_cast<double>(i)), static_cast<double>(i*i)));
+        expect(eq(f.misses(), std::size_t{1000}));
+
+        f.clear();
+        expect(eq(f.hits(), std::size_t{0}));
+        expect(eq(f(x = 1.0), 1.0));
+        expect(eq(f.misses(), std::size_t{1}));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include <cstdlib>
+#include <cmath>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::tree_size_v;
+
+template<typename E> requires(adpp::backward::tree_size_v<E> >= 5)
+struct adpp::backward::outline<E> : std::true_type {};
+
+int main() {
+
+    "tree_size"_test = [] () {
+        var a;
+        var b;
+        static_assert(tree_size_v<decltype(a)> == 1);
+        static_assert(tree_size_v<decltype(a*b)> == 3);
+        static_assert(tree_size_v<decltype(a*b + exp(a))> == 6);
+        static_assert(tree_size_v<decltype((a*b)*(a*b))> == 7);
+    };
+
+    "outlined_evaluate"_test = [] () {
+        constexpr var a;
+        constexpr var b;
+        static_assert(adpp::backward::outline<std::remove_cvref_t<decltype(a*b*a)>>::value);
+        static_assert(!adpp::backward::outline<std::remove_cvref_t<decltype(a*b)>>::value);
+        constexpr auto result = evaluate(a*b + a*b*a, at(a = 2.0, b = 3.0));
+        static_assert(result == 18.0);
+    };
+
+    "outlined_back_propagate"_test = [] () {
+        var a;
+        var b;
+        const auto inner = a*b + exp(a);
+        const auto expression = inner*inner + a;
+
+        const double av = 0.5;
+        const double bv = 2.0;
+        const double inner_value = av*bv + std::exp(av);
+        const auto derivs = grad(expression, at(a = av, b = bv));
+        expect(approx(evaluate(expression, at(a = av, b = bv)), inner_value*inner_value + av, 1e-12));
+        expect(approx(derivs[a], 2.0*inner_value*(bv + std::exp(av)) + 1.0, 1e-12));
+        expect(approx(derivs[b], 2.0*inner_value*av, 1e-12));
+    };
+
+    return EXIT_SUCCESS;
+}
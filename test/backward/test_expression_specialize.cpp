@@ -0,0 +1,81 @@
+#include <cstdlib>
+#include <cmath>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/specialize.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::cval;
+using adpp::backward::specialize;
+
+template<typename T> struct is_precomputed : std::false_type {};
+template<typename E> struct is_precomputed<adpp::backward::precomputed<E>> : std::true_type {};
+
+template<typename T> struct expression_type;
+template<typename E, typename B>
+struct expression_type<adpp::backward::bound_expression<E, B>> : std::type_identity<E> {};
+
+template<typename T>
+using precomputed_nodes_t = adpp::filtered_types_t<
+    is_precomputed,
+    adpp::backward::symbols_t<typename expression_type<std::remove_cvref_t<T>>::type>
+>;
+
+int main() {
+
+    "specialized_expression_evaluate"_test = [] () {
+        static constexpr var x;
+        static constexpr let mu;
+        static constexpr let k;
+        constexpr auto expr = x*(mu*k + exp(k)) + (x + mu)*k;
+        constexpr auto specialized = specialize(expr, at(mu = 3.0, k = 1.5));
+
+        // only the sub-expression (mu*k + exp(k)) is independent of x
+        static_assert(adpp::type_list_size_v<precomputed_nodes_t<decltype(specialized)>> == 1);
+        static_assert(specialized(x = 2.0) == evaluate(expr, at(x = 2.0, mu = 3.0, k = 1.5)));
+        expect(eq(specialized(x = 2.0), evaluate(expr, at(x = 2.0, mu = 3.0, k = 1.5))));
+    };
+
+    "specialized_expression_gradient"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expr = exp(mu*mu)*x*y + y/mu;
+        const auto specialized = specialize(expr, at(mu = 0.5));
+        static_assert(adpp::type_list_size_v<precomputed_nodes_t<decltype(specialized)>> == 1);
+
+        const auto gradient = grad(specialized, at(x = 2.0, y = 3.0));
+        const auto expected = grad(expr, at(x = 2.0, y = 3.0, mu = 0.5));
+        expect(eq(gradient[x], expected[x]));
+        expect(eq(gradient[y], expected[y]));
+        expect(eq(derivative_of(specialized, wrt(y), at(x = 2.0, y = 3.0)), expected[y]));
+    };
+
+    "specialized_expression_fully_bound"_test = [] () {
+        static constexpr let a;
+        static constexpr let b;
+        constexpr auto specialized = specialize(a*b + a, at(a = 2.0, b = 3.0));
+        static_assert(specialized.evaluate() == 8.0);
+    };
+
+    "specialized_expression_differentiate"_test = [] () {
+        var x;
+        let mu;
+        const auto specialized = specialize(x*x*(mu + cval<1>), at(mu = 2.0));
+        const auto derivative = specialized.differentiate(wrt(x));
+        expect(eq(derivative(x = 3.0), 2.0*3.0*3.0));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <cmath>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/substitute.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::cval;
+using adpp::backward::function;
+
+int main() {
+
+    "substitute_yields_fused_expression"_test = [] () {
+        static constexpr var x;
+        static constexpr var y;
+        static constexpr var z;
+        constexpr auto composed = substitute(x*x + x, x, y*z);
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(composed)>, decltype((y*z)*(y*z) + y*z)>);
+        static_assert(evaluate(composed, at(y = 2.0, z = 3.0)) == 36.0 + 6.0);
+    };
+
+    "substitute_back_propagate"_test = [] () {
+        var x;
+        var y;
+        var z;
+        const auto composed = substitute(exp(x)*x, x, y*z + cval<1>);
+        const auto gradient = grad(composed, at(y = 1.0, z = 2.0));
+        const double t = 3.0;
+        const double dt = std::exp(t)*(t + 1.0);
+        expect(eq(gradient[y], dt*2.0));
+        expect(eq(gradient[z], dt*1.0));
+    };
+
+    "substitute_function"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const function outer = x*x*mu;
+        const function inner = exp(y);
+        const auto composed = substitute(outer, x, inner);
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(composed)>, function<decltype(exp(y)*exp(y)*mu)>>);
+        expect(eq(composed(y = 1.0, mu = 2.0), std::exp(1.0)*std::exp(1.0)*2.0));
+        expect(eq(derivative_of(composed, wrt(y), at(y = 1.0, mu = 2.0)), 2.0*std::exp(1.0)*std::exp(1.0)*2.0));
+    };
+
+    "substitute_bound_expression"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        let nu;
+        const auto outer = (x*mu).with(mu = 3.0);
+        const auto inner = (y*nu + cval<1>).with(nu = 2.0);
+        const auto composed = substitute(outer, x, inner);
+        expect(eq(composed.evaluate(at(y = 1.0)), 9.0));
+
+        const auto [value, derivs] = composed.template back_propagate<double>(at(y = 1.0), wrt(y));
+        expect(eq(value, 9.0));
+        expect(eq(derivs[y], 6.0));
+
+        const auto partially_bound = substitute(x*x, x, inner);
+        expect(eq(partially_bound.evaluate(at(y = 2.0)), 25.0));
+    };
+
+    return EXIT_SUCCESS;
+}
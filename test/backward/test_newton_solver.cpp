@@ -1,4 +1,7 @@
 #include <cstdlib>
+#include <array>
+#include <tuple>
+#include <utility>
 
 #include <boost/ut.hpp>
 
@@ -6,6 +9,7 @@
 #include <adpp/backward/operators.hpp>
 #include <adpp/backward/evaluate.hpp>
 #include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/compile.hpp>
 
 using boost::ut::operator""_test;
 using boost::ut::expect;
@@ -16,6 +20,7 @@ using adpp::backward::cval;
 
 using adpp::backward::bind;
 using adpp::backward::function;
+using adpp::backward::compile;
 
 constexpr double newton_solve() {
     double solution = 10.0;
@@ -35,6 +40,33 @@ constexpr double newton_solve() {
     return residual;
 }
 
+constexpr double compiled_newton_solve() {
+    double solution = 10.0;
+
+    var x;
+    const auto f = compile(x*x*cval<2.0> - cval<4.0>, wrt(x));
+
+    auto [residual, gradient] = f.value_and_grad(solution);
+    int it = 0; while (residual > 1e-6 && it < 100) {
+        solution -= residual/gradient[0];
+        std::tie(residual, gradient) = f.value_and_grad(solution);
+        ++it;
+    }
+
+    return residual;
+}
+
+double c_style_newton_solve(double (*f)(double), std::pair<double, std::array<double, 1>> (*df)(double)) {
+    double solution = 10.0;
+    double residual = f(solution);
+    int it = 0; while (residual > 1e-6 && it < 100) {
+        solution -= residual/df(solution).second[0];
+        residual = f(solution);
+        ++it;
+    }
+    return residual;
+}
+
 int main() {
     using boost::ut::operator""_test;
     using boost::ut::expect;
@@ -45,5 +77,17 @@ int main() {
         expect(lt(newton_solve()*newton_solve(), 1e-12));
     };
 
+    "compiled_newton_solver"_test = [] () {
+        static_assert(compiled_newton_solve()*compiled_newton_solve() < 1e-12);
+        expect(lt(compiled_newton_solve()*compiled_newton_solve(), 1e-12));
+    };
+
+    "compiled_function_as_c_callback"_test = [] () {
+        static constexpr var x;
+        using compiled = decltype(compile(x*x*cval<2.0> - cval<4.0>, wrt(x)));
+        const double residual = c_style_newton_solve(&compiled::invoke, &compiled::invoke_with_gradient);
+        expect(lt(residual*residual, 1e-12));
+    };
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <format>
+#include <string>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/parse.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::throws;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::expression_parser;
+
+int main() {
+
+    "parse_exported_expression"_test = [] () {
+        var x;
+        var y;
+        let mu;
+        const auto expression = exp((x + y/x)*mu);
+        const std::string text = std::format("{}", expression.with(x = "x", y = "y", mu = "µ"));
+        expect(eq(text, std::string{"exp((x + y/x)*µ)"}));
+
+        expression_parser parser{"x", "y", "µ"};
+        auto code = parser.parse(text);
+        expect(eq(code.num_inputs(), std::size_t{3}));
+
+        std::array<double, 3> gradient;
+        for (double v : {0.5, 1.0, 2.0}) {
+            const auto values = at(x = v, y = 2.0*v, mu = 0.25);
+            const auto reference = grad(expression, values);
+            expect(eq(code.value_and_grad(std::array{v, 2.0*v, 0.25}, gradient), evaluate(expression, values)));
+            expect(approx(gradient[0], reference[x], 1e-9));
+            expect(approx(gradient[1], reference[y], 1e-9));
+        }
+    };
+
+    "parse_precedence_and_literals"_test = [] () {
+        expression_parser parser{"a", "b"};
+        std::array<double, 2> gradient;
+        expect(eq(parser.parse("1 + 2*a - b/4").evaluate(std::array{3.0, 8.0}), 5.0));
+        expect(eq(parser.parse("a - b - 1").evaluate(std::array{3.0, 8.0}), -6.0));
+        expect(eq(parser.parse("-1*a + -2.5e-1*b").evaluate(std::array{3.0, 8.0}), -5.0));
+        expect(eq(parser.parse("(a + b)*(a - b)").value_and_grad(std::array{3.0, 2.0}, gradient), 5.0));
+        expect(approx(gradient[0], 6.0, 1e-9));
+        expect(approx(gradient[1], -4.0, 1e-9));
+        expect(eq(parser.parse("-a").value_and_grad(std::array{3.0, 2.0}, gradient), -3.0));
+        expect(approx(gradient[0], -1.0, 1e-9));
+        expect(approx(gradient[1], 0.0, 1e-9));
+        expect(eq(parser.parse("--a - - -b").evaluate(std::array{3.0, 8.0}), -5.0));
+        expect(eq(parser.parse("- -2*a").evaluate(std::array{3.0, 8.0}), 6.0));
+    };
+
+    "parse_shares_inputs"_test = [] () {
+        expression_parser parser{"a", "b"};
+        // a, b and the product, unused symbols are not loaded
+        expect(eq(parser.parse("a*a").size(), std::size_t{2}));
+        expect(eq(parser.parse("a*a + b").size(), std::size_t{4}));
+    };
+
+    "parse_lines"_test = [] () {
+        expression_parser parser{"x"};
+        const auto codes = parser.parse_lines("x*x\n\n  exp(x)\r\nx/2\n");
+        expect(eq(codes.size(), std::size_t{3}));
+        auto first = codes[0];
+        auto second = codes[1];
+        auto third = codes[2];
+        expect(eq(first.evaluate(std::array{3.0}), 9.0));
+        expect(eq(second.evaluate(std::array{1.0}), std::exp(1.0)));
+        expect(eq(third.evaluate(std::array{3.0}), 1.5));
+    };
+
+    "parse_invalid_input"_test = [] () {
+        expect(throws([] () { expression_parser{"a", "a"}; }));
+        expect(throws([] () { expression_parser{"1a"}; }));
+
+        expression_parser parser{"a"};
+        expect(throws([&] () { parser.parse(""); }));
+        expect(throws([&] () { parser.parse("a +"); }));
+        expect(throws([&] () { parser.parse("(a"); }));
+        expect(throws([&] () { parser.parse("a)"); }));
+        expect(throws([&] () { parser.parse("b"); }));
+        expect(throws([&] () { parser.parse("log(a)"); }));
+        expect(throws([&] () { parser.parse("a $ a"); }));
+        expect(throws([&] () { parser.parse(std::string(1000, '(') + "a" + std::string(1000, ')')); }));
+        expect(throws([&] () { parser.parse(std::string(1'000'000, '-') + "a"); }));
+    };
+
+    return EXIT_SUCCESS;
+}
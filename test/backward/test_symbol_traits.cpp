@@ -16,6 +16,10 @@ using adpp::backward::let;
 using adpp::backward::val;
 using adpp::backward::constant;
 
+// expressions with more leaves than the bracket depth limit of clang (256 by default)
+#define REPEAT_2(x) (x) + (x)
+#define REPEAT_128(x) REPEAT_2(REPEAT_2(REPEAT_2(REPEAT_2(REPEAT_2(REPEAT_2(REPEAT_2(x)))))))
+
 
 int main() {
 
@@ -33,6 +37,15 @@ int main() {
         static_assert(adpp::contains_decayed_v<std::remove_cvref_t<decltype(d)>, symbols>);
     };
 
+    "symbols_type_trait_of_large_expression"_test = [] () {
+        var a;
+        let b;
+        val c{3};
+        auto expr = REPEAT_128(a*b + c);
+        using symbols = adpp::backward::symbols_t<std::remove_cvref_t<decltype(expr)>>;
+        static_assert(std::is_same_v<symbols, adpp::type_list<decltype(a), decltype(b), decltype(c)>>);
+    };
+
     "unbound_symbols_type_trait"_test = [] () {
         var a;
         let b;
@@ -17,6 +17,9 @@ using adpp::backward::var;
 using adpp::backward::val;
 using adpp::backward::cval;
 using adpp::backward::function;
+using adpp::backward::constant;
+
+using namespace adpp::backward::literals;
 
 
 template<typename T> struct is_value : std::false_type {};
@@ -74,5 +77,21 @@ int main() {
         expect(eq(f(a = 2), 16));
     };
 
+    "compile_time_literals"_test = [] () {
+        static_assert(std::is_same_v<decltype(2_c), constant<2>>);
+        static_assert(std::is_same_v<decltype(1'000_c), constant<1000>>);
+        static_assert(std::is_same_v<decltype(0.5_c), constant<0.5>>);
+        static_assert(std::is_same_v<decltype(2.5e-1_c), constant<0.25>>);
+        static_assert(std::is_same_v<decltype(1e3_c), constant<1000.0>>);
+
+        var a;
+        var b;
+        // equal literals share a node
+        const auto e = 2_c*a + 2_c*b + a*2_c;
+        static_assert(adpp::type_list_size_v<adpp::backward::symbols_t<decltype(e)>> == 3);
+        expect(eq(evaluate(e, at(a = 3.0, b = 4.0)), 20.0));
+        expect(eq(evaluate(0.5_c*a*4_c, at(a = 3.0)), 6.0));
+    };
+
     return EXIT_SUCCESS;
 }
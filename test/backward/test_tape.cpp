@@ -0,0 +1,216 @@
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <limits>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <adpp/backward/symbols.hpp>
+#include <adpp/backward/operators.hpp>
+#include <adpp/backward/evaluate.hpp>
+#include <adpp/backward/differentiate.hpp>
+#include <adpp/backward/tape.hpp>
+
+using boost::ut::operator""_test;
+using boost::ut::expect;
+using boost::ut::eq;
+using boost::ut::throws;
+using boost::ut::approx;
+
+using adpp::backward::var;
+using adpp::backward::let;
+using adpp::backward::tape;
+using adpp::backward::deduplication;
+
+int main() {
+
+    "tape_record"_test = [] () {
+        tape t;
+        auto x = t.input(2.0);
+        auto y = t.input(3.0);
+        auto f = x*y + exp(x)/y - 1.0;
+        expect(eq(f.value(), 6.0 + std::exp(2.0)/3.0 - 1.0));
+        expect(eq(t.num_inputs(), std::size_t{2}));
+        expect(eq(t.size(), std::size_t{8}));
+    };
+
+    "tape_gradient_matches_static_expression"_test = [] () {
+        var a;
+        var b;
+        const auto expression = a*b + exp(a)/b - a;
+
+        tape t;
+        auto x = t.input(2.0);
+        auto y = t.input(3.0);
+        auto f = x*y + exp(x)/y - x;
+
+        std::array<double, 2> gradient;
+        t.gradient(f, gradient);
+        const auto reference = grad(expression, at(a = 2.0, b = 3.0));
+        expect(eq(f.value(), evaluate(expression, at(a = 2.0, b = 3.0))));
+        expect(approx(gradient[0], reference[a], 1e-9));
+        expect(approx(gradient[1], reference[b], 1e-9));
+    };
+
+    "tape_replay"_test = [] () {
+        var a;
+        var b;
+        const auto expression = a*a*b + exp(b);
+
+        tape t;
+        auto x = t.input(0.0);
+        auto y = t.input(0.0);
+        auto f = x*x*y + exp(y);
+
+        std::array<double, 2> gradient;
+        for (double v : {0.5, 1.0, 2.0}) {
+            const std::array inputs{v, 2.0*v};
+            const double value = t.value_and_grad(inputs, f, gradient);
+            const auto reference = grad(expression, at(a = v, b = 2.0*v));
+            expect(eq(value, evaluate(expression, at(a = v, b = 2.0*v))));
+            expect(approx(gradient[0], reference[a], 1e-9));
+            expect(approx(gradient[1], reference[b], 1e-9));
+        }
+    };
+
+    "tape_reset"_test = [] () {
+        tape t{16};
+        auto x = t.input(1.0);
+        auto f = x*x;
+        expect(eq(f.value(), 1.0));
+
+        t.reset();
+        expect(eq(t.size(), std::size_t{0}));
+        expect(eq(t.num_inputs(), std::size_t{0}));
+
+        auto y = t.input(3.0);
+        auto g = y*y*y;
+        std::array<double, 1> gradient;
+        t.gradient(g, gradient);
+        expect(eq(g.value(), 27.0));
+        expect(approx(gradient[0], 27.0, 1e-9));
+    };
+
+    "tape_hash_consing"_test = [] () {
+        tape t{64, deduplication::on};
+        auto x = t.input(2.0);
+        auto y = t.input(3.0);
+        auto f = (x*y + exp(x*y))*(y*x + exp(y*x)) + 2.0*x + 2.0*x;
+        // x, y, x*y, exp(x*y), the sum, the product, 2.0, 2.0*x, and the two outer additions
+        expect(eq(t.size(), std::size_t{10}));
+        expect(eq(t.statistics().recorded, std::size_t{17}));
+        expect(eq(t.statistics().unique, std::size_t{10}));
+
+        tape reference;
+        auto rx = reference.input(2.0);
+        auto ry = reference.input(3.0);
+        auto rf = (rx*ry + exp(rx*ry))*(ry*rx + exp(ry*rx)) + 2.0*rx + 2.0*rx;
+        expect(eq(reference.size(), std::size_t{17}));
+        expect(eq(reference.statistics().deduplication_ratio(), 1.0));
+
+        std::array<double, 2> gradient;
+        std::array<double, 2> reference_gradient;
+        const std::array inputs{0.5, 0.25};
+        expect(eq(t.value_and_grad(inputs, f, gradient), reference.value_and_grad(inputs, rf, reference_gradient)));
+        expect(approx(gradient[0], reference_gradient[0], 1e-9));
+        expect(approx(gradient[1], reference_gradient[1], 1e-9));
+    };
+
+    "tape_hash_consing_after_reset"_test = [] () {
+        tape t{4, deduplication::on};
+        for (int i = 0; i < 3; ++i) {
+            t.reset();
+            auto x = t.input(1.0);
+            auto f = x;
+            for (int n = 0; n < 100; ++n)
+                f = f + x*x + 1.0;
+            // x, x*x, 1.0 and two additions per iteration
+            expect(eq(t.size(), std::size_t{3 + 2*100}));
+            expect(eq(f.value(), 201.0));
+        }
+    };
+
+    "tape_hash_consing_signed_zeros"_test = [] () {
+        tape t{16, deduplication::on};
+        auto x = t.input(1.0);
+        auto positive = 1.0/(x*0.0);
+        auto negative = 1.0/(x*-0.0);
+        expect(eq(positive.value(), std::numeric_limits<double>::infinity()));
+        expect(eq(negative.value(), -std::numeric_limits<double>::infinity()));
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const auto size = t.size();
+        auto a = x + nan;
+        auto b = x + nan;
+        expect(eq(a.index(), b.index()));
+        expect(eq(t.size(), size + 2));
+    };
+
+    "tape_preaccumulation"_test = [] () {
+        var a;
+        var b;
+        let mu;
+        const auto expression = a*b + exp(a)/b - a*mu;
+
+        tape t;
+        auto x = t.input(2.0);
+        auto y = t.input(3.0);
+        auto f = t.record(expression, at(a = x, b = y, mu = 0.5));
+        auto g = f*x;
+        // x, y, the constant for mu, f and g
+        expect(eq(t.size(), std::size_t{5}));
+        expect(eq(f.value(), evaluate(expression, at(a = 2.0, b = 3.0, mu = 0.5))));
+
+        std::array<double, 2> gradient;
+        for (double v : {1.0, 2.0}) {
+            const std::array inputs{v, 3.0*v};
+            const auto values = at(a = v, b = 3.0*v, mu = 0.5);
+            const auto reference = grad(expression, values);
+            const double value = evaluate(expression, values);
+            expect(eq(t.value_and_grad(inputs, g, gradient), value*v));
+            expect(approx(gradient[0], reference[a]*v + value, 1e-9));
+            expect(approx(gradient[1], reference[b]*v, 1e-9));
+        }
+    };
+
+    "tape_preaccumulation_on_nodes"_test = [] () {
+        var a;
+        var b;
+        tape t;
+        auto x = t.input(2.0);
+        auto y = t.input(3.0);
+        auto f = t.record(a*a*b, at(a = x*y, b = exp(x)));
+
+        std::array<double, 2> gradient;
+        t.gradient(f, gradient);
+        expect(eq(f.value(), 36.0*std::exp(2.0)));
+        expect(approx(gradient[0], 2.0*6.0*3.0*std::exp(2.0) + 36.0*std::exp(2.0), 1e-9));
+        expect(approx(gradient[1], 2.0*6.0*2.0*std::exp(2.0), 1e-9));
+    };
+
+    "tape_non_finite_partials"_test = [] () {
+        tape t;
+        auto x = t.input(1.0);
+        auto f = 0.0*(x*std::numeric_limits<double>::infinity());
+        std::array<double, 1> gradient;
+        t.gradient(f, gradient);
+        expect(std::isnan(gradient[0]));
+    };
+
+    "tape_invalid_arguments"_test = [] () {
+        tape t;
+        tape other;
+        auto x = t.input(1.0);
+        auto y = other.input(1.0);
+        expect(throws([&] () { x*y; }));
+        expect(throws([&] () { t.evaluate(std::array<double, 2>{}, x); }));
+        expect(throws([&] () { std::array<double, 0> gradient; t.gradient(x, gradient); }));
+
+        // nodes would otherwise refer to the tape they were copied or moved from
+        static_assert(!std::is_copy_constructible_v<tape<>> && !std::is_move_constructible_v<tape<>>);
+        static_assert(!std::is_copy_assignable_v<tape<>> && !std::is_move_assignable_v<tape<>>);
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+import os
+import sys
+import json
+import argparse
+import subprocess
+
+# Measures runtime, compile time or binary size and compares the results against the corresponding section
+# of a stored baseline file. Exits with an error if any metric exceeds its baseline by more than the tolerance,
+# or if the measurements and the baseline do not cover the same cases and metrics (e.g. a new case, or a case
+# that vanished from the benchmarks). The section is only (re-)recorded with --update, which should be run on
+# the machine that runs the checks.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("kind", choices=["runtime", "compile_time", "binary_size"])
+parser.add_argument("--baseline", required=True, help="The JSON file with the baseline measurements")
+parser.add_argument("--tolerance", type=float, required=False, help="Allowed relative increase of the metrics")
+parser.add_argument("--update", action="store_true", help="Overwrite the baseline with the current measurements")
+parser.add_argument("--work-dir", default=".", help="Directory for intermediate reports")
+parser.add_argument("--benchmark", help="(runtime) The workloads benchmark executable")
+parser.add_argument("--samples", type=int, default=50, help="(runtime) Number of samples per case")
+parser.add_argument("--batch", type=int, default=1000, help="(runtime) Number of calls per sample")
+parser.add_argument("--script", help="(compile_time) The compile_time.py script")
+parser.add_argument("--compiler", help="(compile_time) The C++ compiler to be used")
+parser.add_argument("--include", help="(compile_time) The adpp include directory")
+parser.add_argument("--files", nargs="+", default=[], help="(binary_size) The binaries to be checked")
+args = parser.parse_args()
+
+# instruction counts are deterministic up to a few percent, while times depend on the machine's load
+DEFAULT_TOLERANCES = {"instructions": 0.05, "p50_ns": 0.25, "user_time": 0.25, "object_size": 0.05, "size": 0.05}
+
+
+def measure_runtime() -> dict:
+    report_path = os.path.join(args.work_dir, "perf_runtime.json")
+    subprocess.run([
+        args.benchmark,
+        "--samples", str(args.samples),
+        "--batch", str(args.batch),
+        "--filter", "/adpp",
+        "--output", report_path
+    ], check=True, stdout=subprocess.DEVNULL)
+    with open(report_path) as report:
+        results = json.load(report)["results"]
+
+    # only the adpp cases are gated, the hand-derived and autodiff ones are references
+    metrics = {}
+    for r in results:
+        name = f"{r['workload']}/{r['operation']}"
+        metrics[name] = {"p50_ns": r["p50_ns"]}
+        if r.get("instructions_per_call") is not None:
+            metrics[name]["instructions"] = r["instructions_per_call"]
+    return metrics
+
+
+def measure_compile_time() -> dict:
+    report_path = os.path.join(args.work_dir, "perf_compile_time.json")
+    subprocess.run([
+        sys.executable, args.script,
+        "--depth", "4", "6",
+        "--vars", "4",
+        "--order", "1", "2",
+        "--repetitions", "3",
+        "--compiler", args.compiler,
+        "--include", args.include,
+        "--output", report_path
+    ], check=True, stdout=subprocess.DEVNULL)
+    with open(report_path) as report:
+        results = json.load(report)["results"]
+
+    failed = [r["name"] for r in results if not r["success"]]
+    if failed:
+        raise RuntimeError(f"Compilation of the generated units {failed} failed")
+    return {r["name"]: {"user_time": r["user_time"], "object_size": r["object_size"]} for r in results}
+
+
+def measure_binary_size() -> dict:
+    return {os.path.basename(f): {"size": os.path.getsize(f)} for f in args.files}
+
+
+def compare(current: dict, baseline: dict) -> list:
+    regressions = []
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f"{name}: in the baseline but not measured")
+        regressions.append(f"{name}: missing in the measurements")
+    for name, metrics in sorted(current.items()):
+        if name not in baseline:
+            print(f"{name}: not in the baseline")
+            regressions.append(f"{name}: missing in the baseline")
+            continue
+        # instructions are only missing if they could not be counted on this machine
+        for metric in sorted(baseline[name].keys() - metrics.keys() - {"instructions"}):
+            print(f"{name}: {metric} in the baseline but not measured")
+            regressions.append(f"{name} {metric}: missing in the measurements")
+        # times are only compared if the instructions could not be counted
+        if "instructions" in metrics and "instructions" in baseline[name]:
+            metrics = {"instructions": metrics["instructions"]}
+        for metric, value in metrics.items():
+            reference = baseline[name].get(metric)
+            if reference is None:
+                print(f"{name}: {metric} not in the baseline")
+                regressions.append(f"{name} {metric}: missing in the baseline")
+                continue
+            tolerance = args.tolerance if args.tolerance is not None else DEFAULT_TOLERANCES[metric]
+            ratio = value/reference if reference > 0 else 1.0
+            status = "ok"
+            if ratio > 1.0 + tolerance:
+                status = "REGRESSION"
+                regressions.append(f"{name} {metric}: {value:.4g} vs. {reference:.4g} ({ratio:.2f}x)")
+            elif ratio < 1.0 - tolerance:
+                status = "improved (consider updating the baseline)"
+            print(f"{name}: {metric} {value:.4g} vs. {reference:.4g} ({ratio:.2f}x) {status}")
+    return regressions
+
+
+measure = {"runtime": measure_runtime, "compile_time": measure_compile_time, "binary_size": measure_binary_size}
+current = measure[args.kind]()
+
+baseline = {}
+if os.path.exists(args.baseline):
+    with open(args.baseline) as baseline_file:
+        baseline = json.load(baseline_file)
+
+if args.update:
+    baseline[args.kind] = current
+    with open(args.baseline, "w") as baseline_file:
+        json.dump(baseline, baseline_file, indent=2, sort_keys=True)
+    print(f"Recorded the {args.kind} baseline in {args.baseline}")
+    sys.exit(0)
+
+if args.kind not in baseline:
+    print(f"No {args.kind} baseline in {args.baseline}, record it with --update", file=sys.stderr)
+    sys.exit(1)
+
+regressions = compare(current, baseline[args.kind])
+if regressions:
+    print(f"\n{len(regressions)} {args.kind} regression(s) or mismatch(es) w.r.t. {args.baseline}:", file=sys.stderr)
+    for r in regressions:
+        print(f"  {r}", file=sys.stderr)
+    sys.exit(1)
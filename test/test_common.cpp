@@ -53,5 +53,13 @@ int main() {
         expect(eq(stored.get(), 84.0));
     };
 
+    "variadic_accessor_lookup"_test = [] () {
+        const adpp::variadic_accessor<int, double, char> accessor{1, 2.5, 'c'};
+        static_assert(decltype(accessor.index_of<double>())::value == 1);
+        static_assert(decltype(accessor.index_of('a'))::value == 2);
+        expect(eq(accessor.get(adpp::index_constant<0>{}), 1));
+        expect(eq(accessor.index(0.0), 2.5));
+    };
+
     return EXIT_SUCCESS;
 }
@@ -1,8 +1,24 @@
 #include <cstdlib>
+#include <utility>
 #include <type_traits>
 
 #include <adpp/type_traits.hpp>
 
+template<std::size_t i>
+struct tag {};
+
+template<typename T>
+struct is_even_tag;
+template<std::size_t i>
+struct is_even_tag<tag<i>> : std::bool_constant<i % 2 == 0> {};
+
+template<std::size_t period, std::size_t... i>
+adpp::type_list<tag<i % period>...> make_tags(std::index_sequence<i...>);
+
+// lists that are longer than the bracket depth limit of clang (256 by default)
+template<std::size_t n, std::size_t period = n>
+using tags_t = decltype(make_tags<period>(std::make_index_sequence<n>{}));
+
 int main() {
 
     {
@@ -39,5 +55,53 @@ int main() {
         static_assert(adpp::contains_decayed_v<double, unique_merged>);
     }
 
+    {
+        using unique = adpp::unique_types_t<adpp::type_list<char, int, char, double, int>>;
+        static_assert(std::is_same_v<unique, adpp::type_list<char, int, double>>);
+        static_assert(std::is_same_v<adpp::unique_types_t<adpp::type_list<>>, adpp::type_list<>>);
+    }
+    {
+        using appended = adpp::unique_types_t<adpp::type_list<int>, char, int, double>;
+        static_assert(std::is_same_v<appended, adpp::type_list<int, char, double>>);
+        static_assert(std::is_same_v<adpp::unique_types_t<adpp::type_list<>, char, char>, adpp::type_list<char>>);
+    }
+    {
+        using merged = adpp::merged_types_t<adpp::type_list<int>, adpp::type_list<>, adpp::type_list<char, int>>;
+        static_assert(std::is_same_v<merged, adpp::type_list<int, char, int>>);
+    }
+    {
+        using filtered = adpp::filtered_types_t<std::is_integral, adpp::type_list<int, double, char, float>>;
+        static_assert(std::is_same_v<filtered, adpp::type_list<int, char>>);
+        static_assert(std::is_same_v<adpp::filtered_types_t<std::is_integral, adpp::type_list<>>, adpp::type_list<>>);
+    }
+
+    {
+        static_assert(std::is_same_v<adpp::type_at_t<1, int, char, double>, char>);
+        static_assert(std::is_same_v<adpp::type_at_t<2, adpp::type_list<int, char, double>>, double>);
+        static_assert(adpp::index_of_type_v<char, int, char, char> == 1);
+        static_assert(adpp::index_of_type_v<float, adpp::type_list<int, char>> == 2);
+    }
+    {
+        static_assert(adpp::are_unique_v<>);
+        static_assert(adpp::are_unique_v<int, char, double>);
+        static_assert(!adpp::are_unique_v<int, char, double, char>);
+        static_assert(!adpp::are_unique_v<adpp::type_list<int, int>>);
+        static_assert(adpp::are_unique_v<int, const int&>);
+    }
+    {
+        static_assert(std::is_same_v<adpp::unique_types_t<tags_t<300, 150>>, tags_t<150>>);
+        static_assert(adpp::type_list_size_v<adpp::filtered_types_t<is_even_tag, tags_t<300>>> == 150);
+        static_assert(adpp::is_any_of_v<tag<299>, tags_t<300>>);
+        static_assert(!adpp::is_any_of_v<tag<300>, tags_t<300>>);
+        static_assert(adpp::are_unique_v<tags_t<300>>);
+        static_assert(!adpp::are_unique_v<tags_t<300, 299>>);
+    }
+    {
+        using merged = adpp::merged_unique_types_t<adpp::type_list<int, char>, adpp::type_list<>, adpp::type_list<double, int>>;
+        static_assert(std::is_same_v<merged, adpp::type_list<int, char, double>>);
+        static_assert(std::is_same_v<adpp::merged_unique_types_t<>, adpp::type_list<>>);
+        static_assert(std::is_same_v<adpp::merged_unique_types_t<tags_t<200>, tags_t<300>>, tags_t<300>>);
+    }
+
     return EXIT_SUCCESS;
 }